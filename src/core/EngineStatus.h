@@ -0,0 +1,65 @@
+#ifndef ENGINE_STATUS_H
+#define ENGINE_STATUS_H
+
+#include <cstdint>
+#include <string_view>
+
+using namespace std;
+
+// Outcome of a GymEngine operation (front-ends turn it into messages)
+enum class EngineStatus : uint8_t
+{
+    Ok = 0,
+    InvalidInput,        // Empty name / email
+    InvalidSubscription, // SubscriptionType::Unknown
+    InvalidSpecialty,    // Specialty::Unknown
+    DuplicateEmail,
+    MemberNotFound,
+    TrainerNotFound,
+    AlreadyAssigned,
+    TrainerFull,
+    InvalidCredentials,
+    JournalFailed // The change could not be written to the mutation log (nothing changed)
+};
+
+constexpr string_view engineStatusMessage(EngineStatus status)
+{
+    switch (status)
+    {
+    case EngineStatus::Ok:
+        return "OK";
+    case EngineStatus::InvalidInput:
+        return "Name and email are required";
+    case EngineStatus::InvalidSubscription:
+        return "Invalid subscription type";
+    case EngineStatus::InvalidSpecialty:
+        return "Invalid specialty";
+    case EngineStatus::DuplicateEmail:
+        return "Email is already in use";
+    case EngineStatus::MemberNotFound:
+        return "Member not found";
+    case EngineStatus::TrainerNotFound:
+        return "Trainer not found";
+    case EngineStatus::AlreadyAssigned:
+        return "Member is already assigned to this trainer";
+    case EngineStatus::TrainerFull:
+        return "Trainer has no free slots";
+    case EngineStatus::InvalidCredentials:
+        return "Invalid email or password";
+    case EngineStatus::JournalFailed:
+        return "Could not write the change to the journal";
+    }
+    return "Unknown error";
+}
+
+// Status plus a value (only meaningful when ok())
+template <typename T>
+struct EngineResult
+{
+    EngineStatus status;
+    T value;
+
+    bool ok() const { return status == EngineStatus::Ok; }
+};
+
+#endif
@@ -0,0 +1,984 @@
+#ifndef GYM_ENGINE_H
+#define GYM_ENGINE_H
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../core/EngineStatus.h"
+#include "../core/IdAllocator.h"
+#include "../core/PasswordHash.h"
+#include "../entities/Admin.h"
+#include "../entities/Date.h"
+#include "../entities/Member.h"
+#include "../entities/Specialty.h"
+#include "../entities/Subscription.h"
+#include "../entities/Trainer.h"
+#include "../storage/Aggregates.h"
+#include "../storage/EntityIndex.h"
+#include "../storage/JoinDateIndex.h"
+#include "../storage/MemberColumns.h"
+#include "../storage/SearchIndex.h"
+#include "../storage/SlotMap.h"
+#include "../storage/Snapshot.h"
+#include "../storage/WriteAheadLog.h"
+
+using namespace std;
+
+// A parsed member / trainer row waiting to be added in bulk (imports)
+struct MemberDraft
+{
+    string name, email, password;
+    SubscriptionType type = SubscriptionType::Unknown;
+    Date joinDate;
+};
+
+struct TrainerDraft
+{
+    string name, email, password;
+    Specialty specialty = Specialty::Unknown;
+};
+
+// GymEngine - all gym data and every operation on it, with no I/O
+// Operations take typed arguments and return an EngineStatus (or an
+// EngineResult); they never read the keyboard or print. The console services,
+// batch jobs and benchmarks are front-ends on top of it.
+//
+// Every mutation is written to the journal (when set) before it is applied.
+//
+// Thread safety: one reader/writer lock guards all state. Mutators take it
+// exclusively themselves; lookups that return values (search, authenticate,
+// isMemberAssignedTo) take it shared. Lookups that return pointers, references
+// or views (find*, get*, findMembersJoinedBetween) do not lock: hold readLock()
+// while using what they return, and never call a mutator while holding it.
+// IDs come from lock-free IdAllocators, so they stay unique across threads.
+class GymEngine
+{
+public:
+    using ReadGuard = shared_lock<shared_mutex>;
+
+private:
+    using WriteGuard = unique_lock<shared_mutex>;
+
+    mutable shared_mutex stateLock; // Shared by readers, exclusive for mutators
+
+    // --- Admins ---
+    vector<Admin *> admins;                     // Owned
+    unordered_map<string, Admin *> adminsByEmail; // Email -> admin (login lookups)
+
+    // --- Members ---
+    IdAllocator memberIds;                   // Last member ID handed out (saved in snapshots)
+    SlotMap<Member> members;
+    EntityIndex<Handle<Member>> memberIndex; // ID / email -> member handle
+    MemberColumns memberColumns;             // Column copy for scans / reports
+    JoinDateIndex joinDateIndex;             // Member IDs sorted by join date
+    SearchIndex memberSearch;                // Name / email prefix + fuzzy search
+    MemberAggregates memberStats;            // Counts per tier / join month
+
+    // --- Trainers ---
+    IdAllocator trainerIds;                                  // Last trainer ID handed out (saved in snapshots)
+    SlotMap<Trainer> trainers;
+    EntityIndex<Handle<Trainer>> trainerIndex;               // ID / email -> trainer handle
+    unordered_map<int, vector<int>> trainerIdsByMember;      // Reverse index: member ID -> trainer IDs
+    SearchIndex trainerSearch;                               // Name / email prefix + fuzzy search
+    TrainerLoadHistogram trainerLoad;                        // Trainers per number of assigned members
+
+    WriteAheadLog *journal = nullptr; // Mutation log (nullptr = not logging)
+    uint64_t changeStamp = 0;         // Last revision handed out (see touch); also moved by deletes
+
+    // Log a mutation before it is applied; the caller must not apply it
+    // unless this returns Ok (the record never reached the journal)
+    EngineStatus log(WalRecordType type, const WalPayload &payload)
+    {
+        if (journal != nullptr && journal->append(type, payload) == 0)
+            return EngineStatus::JournalFailed;
+        return EngineStatus::Ok;
+    }
+
+    // Give a stored or changed member / trainer a new revision (never reused,
+    // also across loads), so views cached by revision know it changed
+    void touch(User &entity)
+    {
+        entity.setRevision(++changeStamp);
+    }
+
+    // Default admin and a few members / trainers for testing
+    void seedTestData()
+    {
+        storeAdmin(new Admin("Mohamed Rashad", "admin", PasswordHash::create("123")));
+
+        Member m1(memberIds.next(), "Mohamed", "mohamed@gmail.com", "123", "2024-01-15");
+        m1.setSubscriptionType(SubscriptionType::Standard);
+        storeMember(std::move(m1));
+
+        Member m2(memberIds.next(), "Ahmed", "ahmed@gmail.com", "123", "2024-02-20");
+        m2.setSubscriptionType(SubscriptionType::Premium);
+        storeMember(std::move(m2));
+
+        Member m3(memberIds.next(), "Mostafa", "mostafa@gmail.com", "123", "2024-03-10");
+        m3.setSubscriptionType(SubscriptionType::Standard);
+        storeMember(std::move(m3));
+
+        storeTrainer(Trainer(trainerIds.next(), "Amir", "amir@gmail.com", "trainer123", Specialty::Cardio));
+        storeTrainer(Trainer(trainerIds.next(), "Kareem", "kareem@gmail.com", "trainer456", Specialty::StrengthTraining));
+        storeTrainer(Trainer(trainerIds.next(), "Maged", "maged@gmail.com", "trainer789", Specialty::Yoga));
+    }
+
+    // Store a member and register it in every index (no logging)
+    // (bulk loads pass indexJoinDate = false and rebuild the join date index once)
+    Handle<Member> storeMember(Member member, bool indexJoinDate = true)
+    {
+        int id = member.getId();
+        string email = member.getEmail();
+        touch(member);
+
+        memberColumns.append(member);
+        memberSearch.add(id, member.getName(), email);
+        memberStats.add(member.getSubscriptionType(), member.getJoinDate());
+        if (indexJoinDate)
+            joinDateIndex.add(id, member.getJoinDate());
+
+        Handle<Member> handle = members.insert(std::move(member));
+        memberIndex.add(id, email, handle);
+        return handle;
+    }
+
+    // Store a trainer and register it in every index (no logging)
+    Handle<Trainer> storeTrainer(Trainer trainer)
+    {
+        int id = trainer.getId();
+        string email = trainer.getEmail();
+        touch(trainer);
+
+        trainerSearch.add(id, trainer.getName(), email);
+        trainerLoad.addTrainer(trainer.getAssignedCount());
+
+        Handle<Trainer> handle = trainers.insert(std::move(trainer));
+        trainerIndex.add(id, email, handle);
+        return handle;
+    }
+
+    // Reverse index helpers
+    void linkMember(int memberId, int trainerId)
+    {
+        trainerIdsByMember[memberId].push_back(trainerId);
+    }
+
+    void unlinkMember(int memberId, int trainerId)
+    {
+        auto it = trainerIdsByMember.find(memberId);
+        if (it == trainerIdsByMember.end())
+            return;
+
+        vector<int> &ids = it->second;
+        for (size_t i = 0; i < ids.size(); i++)
+        {
+            if (ids[i] == trainerId)
+            {
+                ids[i] = ids.back();
+                ids.pop_back();
+                break;
+            }
+        }
+        if (ids.empty())
+            trainerIdsByMember.erase(it);
+    }
+
+    // Remove a member from its trainers (cascade of deleteMember)
+    // Only the trainers listed in the reverse index are touched.
+    int removeMemberFromAllTrainers(int memberId, Handle<Member> member)
+    {
+        auto it = trainerIdsByMember.find(memberId);
+        if (it == trainerIdsByMember.end())
+            return 0;
+
+        int removed = 0;
+        for (int trainerId : it->second)
+        {
+            Trainer *trainer = trainers.get(trainerIndex.findById(trainerId));
+            if (trainer != nullptr && trainer->removeMember(member))
+            {
+                touch(*trainer);
+                size_t load = trainer->getAssignedCount();
+                trainerLoad.changeLoad(load + 1, load);
+                removed++;
+            }
+        }
+        trainerIdsByMember.erase(it);
+        return removed;
+    }
+
+    // Build a member with a given ID and tier
+    static Member makeMember(int id, string name, string email, string password, SubscriptionType type, Date joinDate)
+    {
+        Member member(id, std::move(name), std::move(email), std::move(password), joinDate);
+        member.setSubscriptionType(type);
+        return member;
+    }
+
+    Admin *adminWithEmail(const string &email) const
+    {
+        auto it = adminsByEmail.find(email);
+        return it != adminsByEmail.end() ? it->second : nullptr;
+    }
+
+    // Take ownership of an admin and index it by email (no logging)
+    void storeAdmin(Admin *admin)
+    {
+        adminsByEmail[admin->getEmail()] = admin;
+        admins.push_back(admin);
+    }
+
+    // Add an admin whose password is already hashed
+    EngineStatus insertAdmin(const string &name, const string &email, const string &passwordHash)
+    {
+        WriteGuard guard(stateLock);
+        if (adminWithEmail(email) != nullptr)
+            return EngineStatus::DuplicateEmail;
+
+        EngineStatus status =
+            log(WalRecordType::AddAdmin, WalPayload().addString(name).addString(email).addString(passwordHash));
+        if (status != EngineStatus::Ok)
+            return status;
+        storeAdmin(new Admin(name, email, passwordHash));
+        return EngineStatus::Ok;
+    }
+
+    // Hash checked when the email is unknown, so a miss costs as long as a
+    // wrong password and does not reveal which emails exist
+    static const string &unknownAdminHash()
+    {
+        static const string hash = PasswordHash::create("");
+        return hash;
+    }
+
+    // Hashes are stored as they are; older snapshots / logs hold plain passwords
+    static string hashedPassword(string stored)
+    {
+        return PasswordHash::isHash(stored) ? stored : PasswordHash::create(stored);
+    }
+
+    bool isAssigned(int memberId, int trainerId) const
+    {
+        auto it = trainerIdsByMember.find(memberId);
+        if (it == trainerIdsByMember.end())
+            return false;
+        for (int id : it->second)
+        {
+            if (id == trainerId)
+                return true;
+        }
+        return false;
+    }
+
+    // Validation shared by the single and the bulk add
+    EngineStatus checkMember(const string &name, const string &email, SubscriptionType type) const
+    {
+        if (name.empty() || email.empty())
+            return EngineStatus::InvalidInput;
+        if (type == SubscriptionType::Unknown)
+            return EngineStatus::InvalidSubscription;
+        if (memberIndex.containsEmail(email)) // Case-insensitive
+            return EngineStatus::DuplicateEmail;
+        return EngineStatus::Ok;
+    }
+
+    EngineStatus checkTrainer(const string &name, const string &email, Specialty specialty) const
+    {
+        if (name.empty() || email.empty())
+            return EngineStatus::InvalidInput;
+        if (specialty == Specialty::Unknown)
+            return EngineStatus::InvalidSpecialty;
+        if (trainerIndex.containsEmail(email)) // Case-insensitive
+            return EngineStatus::DuplicateEmail;
+        return EngineStatus::Ok;
+    }
+
+    EngineStatus logAddMember(int id, Date joinDate, SubscriptionType type, const string &name, const string &email,
+                      const string &password)
+    {
+        if (journal == nullptr)
+            return EngineStatus::Ok;
+
+        WalPayload payload;
+        payload.addInt(id)
+            .addInt(joinDate.daysSinceEpoch())
+            .addInt((int32_t)type)
+            .addString(name)
+            .addString(email)
+            .addString(password);
+        return log(WalRecordType::AddMember, payload);
+    }
+
+    EngineStatus logAddTrainer(int id, Specialty specialty, const string &name, const string &email, const string &password)
+    {
+        if (journal == nullptr)
+            return EngineStatus::Ok;
+
+        WalPayload payload;
+        payload.addInt(id)
+            .addInt((int32_t)specialty)
+            .addString(name)
+            .addString(email)
+            .addString(password);
+        return log(WalRecordType::AddTrainer, payload);
+    }
+
+    // Re-create a logged member / trainer with its original ID
+    void restoreMember(int id, Date joinDate, int32_t type, string name, string email, string password)
+    {
+        if (memberIndex.containsId(id))
+            return;
+
+        SubscriptionType tier = type >= 0 && (size_t)type < SUBSCRIPTION_TYPE_COUNT ? (SubscriptionType)type
+                                                                                   : SubscriptionType::Unknown;
+        memberIds.observe(id);
+
+        storeMember(makeMember(id, std::move(name), std::move(email), std::move(password), tier, joinDate));
+    }
+
+    void restoreTrainer(int id, int32_t specialty, string name, string email, string password)
+    {
+        if (trainerIndex.containsId(id))
+            return;
+
+        Specialty validSpecialty = specialty >= 0 && (size_t)specialty < SPECIALTY_COUNT ? (Specialty)specialty
+                                                                                       : Specialty::Unknown;
+        trainerIds.observe(id);
+
+        storeTrainer(Trainer(id, std::move(name), std::move(email), std::move(password), validSpecialty));
+    }
+
+public:
+    GymEngine()
+    {
+        seedTestData();
+    }
+
+    GymEngine(const GymEngine &) = delete;
+    GymEngine &operator=(const GymEngine &) = delete;
+
+    ~GymEngine()
+    {
+        for (Admin *admin : admins)
+            delete admin;
+    }
+
+    // Shared lock for reading through pointers / references / views
+    ReadGuard readLock() const { return ReadGuard(stateLock); }
+
+    // Moves on every add / change / delete of a member or trainer: entities
+    // with a larger getRevision() changed after it was read (hold readLock())
+    uint64_t revision() const { return changeStamp; }
+
+    // ==================== ADMINS ====================
+
+    // The name of the admin with these credentials (InvalidCredentials otherwise)
+    // One lookup by email, then one salted hash check done outside the lock:
+    // the cost does not depend on the number of admins.
+    EngineResult<string> authenticate(const string &email, const string &password) const
+    {
+        string name, passwordHash;
+        {
+            ReadGuard guard(stateLock);
+            const Admin *admin = adminWithEmail(email);
+            if (admin != nullptr)
+            {
+                name = admin->getName();
+                passwordHash = admin->getPassword();
+            }
+        }
+
+        if (passwordHash.empty())
+        {
+            PasswordHash::verify(unknownAdminHash(), password);
+            return {EngineStatus::InvalidCredentials, string()};
+        }
+        if (!PasswordHash::verify(passwordHash, password))
+            return {EngineStatus::InvalidCredentials, string()};
+        return {EngineStatus::Ok, name};
+    }
+
+    Admin *findAdminByEmail(const string &email) const
+    {
+        ReadGuard guard(stateLock);
+        return adminWithEmail(email);
+    }
+
+    EngineStatus addAdmin(const string &name, const string &email, const string &password)
+    {
+        if (name.empty() || email.empty())
+            return EngineStatus::InvalidInput;
+        if (findAdminByEmail(email) != nullptr)
+            return EngineStatus::DuplicateEmail; // Checked again under the write lock
+
+        // Hashing is slow on purpose: do it before taking the lock
+        return insertAdmin(name, email, PasswordHash::create(password));
+    }
+
+    // ==================== MEMBERS ====================
+
+    // Register a member; the result holds its new ID
+    EngineResult<int> addMember(const string &name, const string &email, const string &password,
+                                SubscriptionType type, Date joinDate = Date::today())
+    {
+        WriteGuard guard(stateLock);
+        EngineStatus status = checkMember(name, email, type);
+        if (status != EngineStatus::Ok)
+            return {status, 0};
+
+        int id = reserveMemberIds(1);
+        status = logAddMember(id, joinDate, type, name, email, password);
+        if (status != EngineStatus::Ok)
+            return {status, 0};
+        storeMember(makeMember(id, name, email, password, type, joinDate));
+        return {EngineStatus::Ok, id};
+    }
+
+    EngineStatus changeSubscription(int id, SubscriptionType type)
+    {
+        if (type == SubscriptionType::Unknown)
+            return EngineStatus::InvalidSubscription;
+
+        WriteGuard guard(stateLock);
+        Member *member = members.get(memberIndex.findById(id));
+        if (member == nullptr)
+            return EngineStatus::MemberNotFound;
+
+        EngineStatus status = log(WalRecordType::UpdateMember, WalPayload().addInt(id).addInt((int32_t)type));
+        if (status != EngineStatus::Ok)
+            return status;
+
+        memberStats.changeTier(member->getSubscriptionType(), type);
+        member->setSubscriptionType(type);
+        touch(*member);
+        memberColumns.setSubscription(id, type);
+        return EngineStatus::Ok;
+    }
+
+    // Delete a member and drop it from its trainers
+    // 'unassigned' (optional) receives how many trainers it was removed from.
+    EngineStatus deleteMember(int id, int *unassigned = nullptr)
+    {
+        WriteGuard guard(stateLock);
+        Handle<Member> handle = memberIndex.findById(id);
+        Member *member = members.get(handle);
+        if (member == nullptr)
+            return EngineStatus::MemberNotFound;
+
+        EngineStatus status = log(WalRecordType::DeleteMember, WalPayload().addInt(id));
+        if (status != EngineStatus::Ok)
+            return status;
+
+        // --- CASCADING DELETE ---
+        // Drop the member's handle from the trainers it is assigned to
+        // (only those trainers are visited, through the reverse index).
+        int removed = removeMemberFromAllTrainers(id, handle);
+        if (unassigned != nullptr)
+            *unassigned = removed;
+
+        memberIndex.remove(id, member->getEmail());
+        memberColumns.remove(id);
+        joinDateIndex.remove(id, member->getJoinDate());
+        memberSearch.remove(id);
+        memberStats.remove(member->getSubscriptionType(), member->getJoinDate());
+        members.erase(handle);
+        changeStamp++;
+        return EngineStatus::Ok;
+    }
+
+    size_t memberCount() const
+    {
+        ReadGuard guard(stateLock);
+        return members.size();
+    }
+
+    // Lookups - hold readLock() while using the results
+    // (pointers are valid until the next add / delete)
+    const Member *findMember(int id) const { return members.get(memberIndex.findById(id)); }
+    const Member *findMemberByEmail(const string &email) const { return members.get(memberIndex.findByEmail(email)); }
+
+    const SlotMap<Member> &getMembers() const { return members; }
+    const MemberColumns &getMemberColumns() const { return memberColumns; }
+    const MemberAggregates &getMemberStats() const { return memberStats; }
+    const SearchIndex &getMemberSearch() const { return memberSearch; }
+
+    // Members who joined between 'from' and 'to' (inclusive), oldest first
+    // The range is lazy: page() it and resolve the IDs you actually show.
+    JoinDateRange findMembersJoinedBetween(Date from, Date to) const
+    {
+        return joinDateIndex.range(from, to);
+    }
+
+    vector<SearchHit> searchMembers(string_view query, size_t limit = SearchIndex::DEFAULT_RESULTS) const
+    {
+        ReadGuard guard(stateLock);
+        return memberSearch.search(query, limit);
+    }
+
+    // ==================== TRAINERS ====================
+
+    // Register a trainer; the result holds its new ID
+    EngineResult<int> addTrainer(const string &name, const string &email, const string &password, Specialty specialty)
+    {
+        WriteGuard guard(stateLock);
+        EngineStatus status = checkTrainer(name, email, specialty);
+        if (status != EngineStatus::Ok)
+            return {status, 0};
+
+        int id = reserveTrainerIds(1);
+        status = logAddTrainer(id, specialty, name, email, password);
+        if (status != EngineStatus::Ok)
+            return {status, 0};
+        storeTrainer(Trainer(id, name, email, password, specialty));
+        return {EngineStatus::Ok, id};
+    }
+
+    EngineStatus changeSpecialty(int id, Specialty specialty)
+    {
+        if (specialty == Specialty::Unknown)
+            return EngineStatus::InvalidSpecialty;
+
+        WriteGuard guard(stateLock);
+        Trainer *trainer = trainers.get(trainerIndex.findById(id));
+        if (trainer == nullptr)
+            return EngineStatus::TrainerNotFound;
+
+        EngineStatus status =
+            log(WalRecordType::UpdateTrainerSpecialty, WalPayload().addInt(id).addInt((int32_t)specialty));
+        if (status != EngineStatus::Ok)
+            return status;
+
+        trainer->setTrainerSpecialty(specialty);
+        touch(*trainer);
+        return EngineStatus::Ok;
+    }
+
+    EngineStatus assignMember(int trainerId, int memberId)
+    {
+        WriteGuard guard(stateLock);
+        Trainer *trainer = trainers.get(trainerIndex.findById(trainerId));
+        if (trainer == nullptr)
+            return EngineStatus::TrainerNotFound;
+
+        Handle<Member> member = memberIndex.findById(memberId);
+        if (!members.contains(member))
+            return EngineStatus::MemberNotFound;
+        if (isAssigned(memberId, trainerId))
+            return EngineStatus::AlreadyAssigned;
+        if (trainer->getAssignedCount() >= Trainer::MAX_ASSIGNED_MEMBERS)
+            return EngineStatus::TrainerFull;
+
+        EngineStatus status = log(WalRecordType::AssignMember, WalPayload().addInt(trainerId).addInt(memberId));
+        if (status != EngineStatus::Ok)
+            return status;
+
+        size_t load = trainer->getAssignedCount();
+        trainer->addAssignedMember(member);
+        touch(*trainer);
+        trainerLoad.changeLoad(load, load + 1);
+        linkMember(memberId, trainerId);
+        return EngineStatus::Ok;
+    }
+
+    EngineStatus deleteTrainer(int id)
+    {
+        WriteGuard guard(stateLock);
+        Handle<Trainer> handle = trainerIndex.findById(id);
+        Trainer *trainer = trainers.get(handle);
+        if (trainer == nullptr)
+            return EngineStatus::TrainerNotFound;
+
+        EngineStatus status = log(WalRecordType::DeleteTrainer, WalPayload().addInt(id));
+        if (status != EngineStatus::Ok)
+            return status;
+
+        // Drop this trainer from the reverse index of its members
+        for (Handle<Member> memberHandle : trainer->getAssignedMembers())
+        {
+            const Member *member = members.get(memberHandle);
+            if (member != nullptr)
+                unlinkMember(member->getId(), id);
+        }
+
+        trainerIndex.remove(id, trainer->getEmail());
+        trainerSearch.remove(id);
+        trainerLoad.removeTrainer(trainer->getAssignedCount());
+        trainers.erase(handle);
+        changeStamp++;
+        return EngineStatus::Ok;
+    }
+
+    size_t trainerCount() const
+    {
+        ReadGuard guard(stateLock);
+        return trainers.size();
+    }
+
+    // Lookups - hold readLock() while using the results
+    // (pointers are valid until the next add / delete)
+    const Trainer *findTrainer(int id) const { return trainers.get(trainerIndex.findById(id)); }
+    const Trainer *findTrainerByEmail(const string &email) const { return trainers.get(trainerIndex.findByEmail(email)); }
+
+    const SlotMap<Trainer> &getTrainers() const { return trainers; }
+    const TrainerLoadHistogram &getTrainerLoad() const { return trainerLoad; }
+    const SearchIndex &getTrainerSearch() const { return trainerSearch; }
+
+    vector<SearchHit> searchTrainers(string_view query, size_t limit = SearchIndex::DEFAULT_RESULTS) const
+    {
+        ReadGuard guard(stateLock);
+        return trainerSearch.search(query, limit);
+    }
+
+    // Trainer IDs a member is assigned to (empty if none; hold readLock())
+    const vector<int> &getTrainerIdsOfMember(int memberId) const
+    {
+        static const vector<int> none;
+        auto it = trainerIdsByMember.find(memberId);
+        return it != trainerIdsByMember.end() ? it->second : none;
+    }
+
+    bool isMemberAssignedTo(int memberId, int trainerId) const
+    {
+        ReadGuard guard(stateLock);
+        return isAssigned(memberId, trainerId);
+    }
+
+    // ==================== BULK IMPORT ====================
+
+    // Reserve 'count' consecutive IDs, returns the first one (lock-free, atomic)
+    int reserveMemberIds(size_t count)
+    {
+        return memberIds.reserve(count);
+    }
+
+    int reserveTrainerIds(size_t count)
+    {
+        return trainerIds.reserve(count);
+    }
+
+    // Add a batch of members in one go (drafts are moved from)
+    // Each draft is validated like addMember (emails must also be unique within
+    // the batch); the valid ones get one block of IDs, are logged and stored, and
+    // their join dates are merged into the index at once. statuses[i] is the
+    // outcome of drafts[i] (JournalFailed if it could not be logged; it is not
+    // stored then). Returns how many members were added.
+    size_t addMembers(vector<MemberDraft> &drafts, vector<EngineStatus> &statuses)
+    {
+        WriteGuard guard(stateLock);
+        statuses.assign(drafts.size(), EngineStatus::Ok);
+        unordered_set<string> batchEmails;
+        batchEmails.reserve(drafts.size());
+
+        size_t valid = 0;
+        for (size_t i = 0; i < drafts.size(); i++)
+        {
+            const MemberDraft &draft = drafts[i];
+            EngineStatus status = checkMember(draft.name, draft.email, draft.type);
+            if (status == EngineStatus::Ok &&
+                !batchEmails.insert(EntityIndex<Handle<Member>>::normalizeEmail(draft.email)).second)
+                status = EngineStatus::DuplicateEmail;
+
+            statuses[i] = status;
+            if (status == EngineStatus::Ok)
+                valid++;
+        }
+        if (valid == 0)
+            return 0;
+
+        vector<JoinDateEntry> joinDates;
+        joinDates.reserve(valid);
+
+        size_t added = 0;
+        int id = reserveMemberIds(valid);
+        for (size_t i = 0; i < drafts.size(); i++)
+        {
+            if (statuses[i] != EngineStatus::Ok)
+                continue;
+
+            MemberDraft &draft = drafts[i];
+            statuses[i] = logAddMember(id, draft.joinDate, draft.type, draft.name, draft.email, draft.password);
+            if (statuses[i] != EngineStatus::Ok)
+            {
+                id++; // The reserved ID is left unused
+                continue;
+            }
+            joinDates.push_back({draft.joinDate.daysSinceEpoch(), id});
+            storeMember(makeMember(id, std::move(draft.name), std::move(draft.email), std::move(draft.password),
+                                   draft.type, draft.joinDate),
+                        false);
+            id++;
+            added++;
+        }
+        joinDateIndex.merge(std::move(joinDates));
+        return added;
+    }
+
+    // Add a batch of trainers in one go (same rules as addMembers)
+    size_t addTrainers(vector<TrainerDraft> &drafts, vector<EngineStatus> &statuses)
+    {
+        WriteGuard guard(stateLock);
+        statuses.assign(drafts.size(), EngineStatus::Ok);
+        unordered_set<string> batchEmails;
+        batchEmails.reserve(drafts.size());
+
+        size_t valid = 0;
+        for (size_t i = 0; i < drafts.size(); i++)
+        {
+            const TrainerDraft &draft = drafts[i];
+            EngineStatus status = checkTrainer(draft.name, draft.email, draft.specialty);
+            if (status == EngineStatus::Ok &&
+                !batchEmails.insert(EntityIndex<Handle<Trainer>>::normalizeEmail(draft.email)).second)
+                status = EngineStatus::DuplicateEmail;
+
+            statuses[i] = status;
+            if (status == EngineStatus::Ok)
+                valid++;
+        }
+        if (valid == 0)
+            return 0;
+
+        size_t added = 0;
+        int id = reserveTrainerIds(valid);
+        for (size_t i = 0; i < drafts.size(); i++)
+        {
+            if (statuses[i] != EngineStatus::Ok)
+                continue;
+
+            TrainerDraft &draft = drafts[i];
+            statuses[i] = logAddTrainer(id, draft.specialty, draft.name, draft.email, draft.password);
+            if (statuses[i] != EngineStatus::Ok)
+            {
+                id++; // The reserved ID is left unused
+                continue;
+            }
+            storeTrainer(Trainer(id, std::move(draft.name), std::move(draft.email), std::move(draft.password),
+                                 draft.specialty));
+            id++;
+            added++;
+        }
+        return added;
+    }
+
+    // ==================== PERSISTENCE ====================
+
+    // Log every mutation to 'log' from now on (nullptr stops logging)
+    void setJournal(WriteAheadLog *log)
+    {
+        WriteGuard guard(stateLock);
+        journal = log;
+    }
+
+    // Re-apply one logged mutation (the journal must be off while replaying)
+    void applyLogRecord(WalRecord &record)
+    {
+        switch (record.type)
+        {
+        case WalRecordType::AddMember:
+        {
+            int id = record.readInt();
+            Date joinDate(record.readInt());
+            int32_t type = record.readInt();
+            string name(record.readString());
+            string email(record.readString());
+            string password(record.readString());
+            if (record.ok())
+            {
+                WriteGuard guard(stateLock);
+                restoreMember(id, joinDate, type, std::move(name), std::move(email), std::move(password));
+            }
+            break;
+        }
+        case WalRecordType::UpdateMember:
+        {
+            int id = record.readInt();
+            int32_t type = record.readInt();
+            if (record.ok() && type >= 0 && (size_t)type < SUBSCRIPTION_TYPE_COUNT)
+                changeSubscription(id, (SubscriptionType)type);
+            break;
+        }
+        case WalRecordType::DeleteMember:
+        {
+            int id = record.readInt();
+            if (record.ok())
+                deleteMember(id);
+            break;
+        }
+        case WalRecordType::AddTrainer:
+        {
+            int id = record.readInt();
+            int32_t specialty = record.readInt();
+            string name(record.readString());
+            string email(record.readString());
+            string password(record.readString());
+            if (record.ok())
+            {
+                WriteGuard guard(stateLock);
+                restoreTrainer(id, specialty, std::move(name), std::move(email), std::move(password));
+            }
+            break;
+        }
+        case WalRecordType::UpdateTrainerSpecialty:
+        {
+            int id = record.readInt();
+            int32_t specialty = record.readInt();
+            if (record.ok() && specialty >= 0 && (size_t)specialty < SPECIALTY_COUNT)
+                changeSpecialty(id, (Specialty)specialty);
+            break;
+        }
+        case WalRecordType::AssignMember:
+        {
+            int trainerId = record.readInt();
+            int memberId = record.readInt();
+            if (record.ok())
+                assignMember(trainerId, memberId);
+            break;
+        }
+        case WalRecordType::DeleteTrainer:
+        {
+            int id = record.readInt();
+            if (record.ok())
+                deleteTrainer(id);
+            break;
+        }
+        case WalRecordType::AddAdmin:
+        {
+            string name(record.readString());
+            string email(record.readString());
+            string password(record.readString());
+            if (record.ok())
+                insertAdmin(name, email, hashedPassword(password));
+            break;
+        }
+        }
+    }
+
+    // Write everything into a snapshot (hold readLock() around it)
+    void saveTo(SnapshotWriter &writer) const
+    {
+        writer.reserve(admins.size(), members.size(), trainers.size());
+        writer.setNextIds(memberIds.highWaterMark(), trainerIds.highWaterMark());
+
+        for (const Admin *admin : admins)
+            writer.addAdmin(admin->getName(), admin->getEmail(), admin->getPassword());
+
+        for (const Member &member : members)
+        {
+            writer.addMember(member.getId(), member.getJoinDate(), member.getSubscriptionType(),
+                             member.getName(), member.getEmail(), member.getPassword());
+        }
+
+        for (const Trainer &trainer : trainers)
+        {
+            writer.addTrainer(trainer.getId(), trainer.getTrainerSpecialty(),
+                              trainer.getName(), trainer.getEmail(), trainer.getPassword());
+
+            for (Handle<Member> handle : trainer.getAssignedMembers())
+            {
+                const Member *member = members.get(handle);
+                if (member != nullptr)
+                    writer.addAssignment(trainer.getId(), member->getId());
+            }
+        }
+    }
+
+    // Replace everything (including the test data) with the snapshot's
+    // Admins are kept if the snapshot has none, so the default admin survives.
+    void loadFrom(const SnapshotReader &reader)
+    {
+        WriteGuard guard(stateLock);
+
+        // --- Admins ---
+        if (reader.adminCount() > 0)
+        {
+            for (Admin *admin : admins)
+                delete admin;
+            admins.clear();
+            adminsByEmail.clear();
+
+            admins.reserve(reader.adminCount());
+            adminsByEmail.reserve(reader.adminCount());
+            for (size_t i = 0; i < reader.adminCount(); i++)
+            {
+                AdminRecord record = reader.admin(i);
+                storeAdmin(new Admin(string(reader.text(record.name)), string(reader.text(record.email)),
+                                     hashedPassword(string(reader.text(record.password)))));
+            }
+        }
+
+        // --- Members ---
+        changeStamp++; // Even an empty snapshot changes what views show
+        members.clear();
+        memberIndex.clear();
+        memberColumns = MemberColumns();
+        memberSearch.clear();
+        memberStats.clear();
+
+        size_t memberCount = reader.memberCount();
+        members.reserve(memberCount);
+        memberIndex.reserve(memberCount);
+        memberColumns.reserve(memberCount);
+        memberSearch.reserve(memberCount);
+
+        vector<JoinDateEntry> joinDates;
+        joinDates.reserve(memberCount);
+
+        // IDs come from the snapshot, not from the allocator
+        for (size_t i = 0; i < memberCount; i++)
+        {
+            MemberRecord record = reader.member(i);
+
+            Member member(record.id, string(reader.text(record.name)), string(reader.text(record.email)),
+                          string(reader.text(record.password)), Date(record.joinDays));
+            if (record.subscription < SUBSCRIPTION_TYPE_COUNT)
+                member.setSubscriptionType((SubscriptionType)record.subscription);
+
+            joinDates.push_back({record.joinDays, record.id});
+            storeMember(std::move(member), false);
+        }
+        memberIds.restore(reader.nextMemberId());
+
+        joinDateIndex.assign(std::move(joinDates)); // One sort instead of n inserts
+
+        // --- Trainers (assignments resolve through the member index) ---
+        trainers.clear();
+        trainerIndex.clear();
+        trainerIdsByMember.clear();
+        trainerSearch.clear();
+        trainerLoad.clear();
+
+        trainers.reserve(reader.trainerCount());
+        trainerIndex.reserve(reader.trainerCount());
+        trainerSearch.reserve(reader.trainerCount());
+
+        for (size_t i = 0; i < reader.trainerCount(); i++)
+        {
+            TrainerRecord record = reader.trainer(i);
+            Specialty specialty = record.specialty < SPECIALTY_COUNT ? (Specialty)record.specialty : Specialty::Unknown;
+
+            storeTrainer(Trainer(record.id, string(reader.text(record.name)), string(reader.text(record.email)),
+                                 string(reader.text(record.password)), specialty));
+        }
+        trainerIds.restore(reader.nextTrainerId());
+
+        for (size_t i = 0; i < reader.assignmentCount(); i++)
+        {
+            AssignmentRecord record = reader.assignment(i);
+            Trainer *trainer = trainers.get(trainerIndex.findById(record.trainerId));
+            Handle<Member> member = memberIndex.findById(record.memberId);
+
+            if (trainer != nullptr && !member.isNull() && trainer->addAssignedMember(member))
+            {
+                touch(*trainer);
+                size_t load = trainer->getAssignedCount();
+                trainerLoad.changeLoad(load - 1, load);
+                linkMember(record.memberId, record.trainerId);
+            }
+        }
+    }
+};
+
+#endif
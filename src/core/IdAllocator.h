@@ -0,0 +1,46 @@
+#ifndef ID_ALLOCATOR_H
+#define ID_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+// IdAllocator - hands out increasing IDs without locks
+// It only remembers the last ID handed out (its high-water mark), so a block
+// of any size costs one atomic add, and persistence just saves / restores
+// that one number. IDs are never reused, even after a delete.
+class IdAllocator
+{
+private:
+    atomic<int> lastId;
+
+public:
+    explicit IdAllocator(int last = 0) : lastId(last) {}
+
+    IdAllocator(const IdAllocator &) = delete;
+    IdAllocator &operator=(const IdAllocator &) = delete;
+
+    // One new ID
+    int next() { return reserve(1); }
+
+    // Reserve 'count' consecutive IDs in one step, returns the first one
+    int reserve(size_t count) { return lastId.fetch_add((int)count, memory_order_relaxed) + 1; }
+
+    // Last ID handed out (0 if none)
+    int highWaterMark() const { return lastId.load(memory_order_relaxed); }
+
+    // Continue after 'last' (e.g. the value saved in a snapshot)
+    void restore(int last) { lastId.store(last, memory_order_relaxed); }
+
+    // Make sure an ID that already exists (e.g. a replayed one) is never handed out
+    void observe(int id)
+    {
+        int last = lastId.load(memory_order_relaxed);
+        while (last < id && !lastId.compare_exchange_weak(last, id, memory_order_relaxed))
+        {
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef PASSWORD_HASH_H
+#define PASSWORD_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "../storage/Sha256.h"
+
+using namespace std;
+
+// PasswordHash - salted, slow password hashes (PBKDF2-HMAC-SHA256, RFC 8018)
+// Stored as one self-describing string, so it fits the old password field of
+// snapshots and log records unchanged:
+//
+//   pbkdf2-sha256$<iterations>$<salt, hex>$<hash, hex>
+//
+// The iteration count travels with the hash, so it can be raised later
+// without breaking the accounts saved earlier. Comparisons never stop at the
+// first differing byte.
+class PasswordHash
+{
+public:
+    static const int ITERATIONS = 10000; // About 10 ms per login on one core
+    static const size_t SALT_SIZE = 16;
+
+private:
+    static constexpr const char *PREFIX = "pbkdf2-sha256$";
+    static const size_t PREFIX_LENGTH = 14;
+
+    static void derive(const string &password, const uint8_t *salt, size_t saltLength, int iterations,
+                       uint8_t *key)
+    {
+        HmacSha256 mac(password.data(), password.size());
+        const uint8_t blockIndex[4] = {0, 0, 0, 1}; // One 32-byte output block
+        uint8_t u[Sha256::DIGEST_SIZE];
+        mac.compute(salt, saltLength, blockIndex, sizeof(blockIndex), u);
+        memcpy(key, u, sizeof(u));
+        for (int i = 1; i < iterations; i++)
+        {
+            mac.compute(u, sizeof(u), nullptr, 0, u);
+            for (size_t b = 0; b < sizeof(u); b++)
+                key[b] ^= u[b];
+        }
+    }
+
+    static int hexDigit(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        return -1;
+    }
+
+    // Split an encoded hash; false if it is not one
+    static bool parse(const string &encoded, int &iterations, uint8_t *salt, uint8_t *hash)
+    {
+        if (encoded.compare(0, PREFIX_LENGTH, PREFIX) != 0)
+            return false;
+        size_t saltAt = encoded.find('$', PREFIX_LENGTH);
+        if (saltAt == string::npos || saltAt == PREFIX_LENGTH || saltAt - PREFIX_LENGTH > 7)
+            return false;
+        saltAt++;
+        size_t hashAt = saltAt + 2 * SALT_SIZE + 1;
+        if (encoded.size() != hashAt + 2 * Sha256::DIGEST_SIZE || encoded[hashAt - 1] != '$')
+            return false;
+
+        iterations = 0;
+        for (size_t i = PREFIX_LENGTH; i < saltAt - 1; i++)
+        {
+            if (encoded[i] < '0' || encoded[i] > '9')
+                return false;
+            iterations = iterations * 10 + (encoded[i] - '0');
+        }
+        return iterations > 0 && fromHex(encoded, saltAt, SALT_SIZE, salt) &&
+               fromHex(encoded, hashAt, Sha256::DIGEST_SIZE, hash);
+    }
+
+public:
+    // Lower-case hex (hashes, salts and session tokens)
+    static string toHex(const uint8_t *bytes, size_t length)
+    {
+        static const char DIGITS[] = "0123456789abcdef";
+        string hex(length * 2, '0');
+        for (size_t i = 0; i < length; i++)
+        {
+            hex[2 * i] = DIGITS[bytes[i] >> 4];
+            hex[2 * i + 1] = DIGITS[bytes[i] & 0xF];
+        }
+        return hex;
+    }
+
+    // Decode 'length' bytes from the hex digits at 'start' (false on a bad digit)
+    static bool fromHex(string_view hex, size_t start, size_t length, uint8_t *bytes)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            int high = hexDigit(hex[start + 2 * i]);
+            int low = hexDigit(hex[start + 2 * i + 1]);
+            if (high < 0 || low < 0)
+                return false;
+            bytes[i] = (uint8_t)(high << 4 | low);
+        }
+        return true;
+    }
+
+    // Fill 'bytes' from the OS random source
+    static void randomBytes(uint8_t *bytes, size_t length)
+    {
+        thread_local random_device source;
+        for (size_t i = 0; i < length; i += 4)
+        {
+            uint32_t word = source();
+            for (size_t b = 0; b < 4 && i + b < length; b++)
+                bytes[i + b] = (uint8_t)(word >> (8 * b));
+        }
+    }
+
+    // Same bytes? Takes as long whatever the first difference
+    static bool constantTimeEquals(const uint8_t *a, const uint8_t *b, size_t length)
+    {
+        uint8_t difference = 0;
+        for (size_t i = 0; i < length; i++)
+            difference |= a[i] ^ b[i];
+        return difference == 0;
+    }
+
+    // Hash a password under a fresh random salt
+    static string create(const string &password, int iterations = ITERATIONS)
+    {
+        uint8_t salt[SALT_SIZE];
+        randomBytes(salt, sizeof(salt));
+        uint8_t hash[Sha256::DIGEST_SIZE];
+        derive(password, salt, sizeof(salt), iterations, hash);
+        return string(PREFIX) + to_string(iterations) + "$" + toHex(salt, sizeof(salt)) + "$" +
+               toHex(hash, sizeof(hash));
+    }
+
+    // Does 'password' produce this hash? (false for anything that is not a hash)
+    static bool verify(const string &encoded, const string &password)
+    {
+        int iterations;
+        uint8_t salt[SALT_SIZE];
+        uint8_t expected[Sha256::DIGEST_SIZE];
+        if (!parse(encoded, iterations, salt, expected))
+            return false;
+
+        uint8_t actual[Sha256::DIGEST_SIZE];
+        derive(password, salt, sizeof(salt), iterations, actual);
+        return constantTimeEquals(actual, expected, sizeof(actual));
+    }
+
+    // Is this an encoded hash (rather than a password saved before hashing)?
+    static bool isHash(const string &encoded)
+    {
+        int iterations;
+        uint8_t salt[SALT_SIZE];
+        uint8_t hash[Sha256::DIGEST_SIZE];
+        return parse(encoded, iterations, salt, hash);
+    }
+};
+
+#endif
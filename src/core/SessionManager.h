@@ -0,0 +1,189 @@
+#ifndef SESSION_MANAGER_H
+#define SESSION_MANAGER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../core/EngineStatus.h"
+#include "../core/GymEngine.h"
+#include "../core/PasswordHash.h"
+
+using namespace std;
+
+// Who a session token stands for
+struct AdminSession
+{
+    string email;
+    string name;
+};
+
+// SessionManager - any number of admins logged in at once
+// login() checks the password once (see GymEngine::authenticate) and hands
+// out a random token; later requests present the token instead. A token is
+// 48 hex digits: an 8-byte session ID, found with one hash lookup, followed by
+// a 16-byte secret compared in constant time. Sessions end on logout() or
+// after 'idleTimeout' without use. All methods are thread safe.
+class SessionManager
+{
+public:
+    using Clock = chrono::steady_clock;
+
+    static constexpr chrono::minutes DEFAULT_IDLE_TIMEOUT{30};
+    static const size_t ID_SIZE = 8;
+    static const size_t SECRET_SIZE = 16;
+    static const size_t TOKEN_LENGTH = 2 * (ID_SIZE + SECRET_SIZE);
+
+private:
+    static const size_t SWEEP_EVERY = 256; // Logins between sweeps of idle sessions
+
+    struct Entry
+    {
+        array<uint8_t, SECRET_SIZE> secret;
+        AdminSession admin;
+        Clock::time_point lastUsed;
+    };
+
+    const GymEngine &engine;
+    Clock::duration idleTimeout;
+
+    mutable mutex lock;
+    unordered_map<uint64_t, Entry> sessions; // Session ID -> session
+    size_t loginsSinceSweep = 0;
+
+    // Split a token into its ID and secret (false if it is malformed)
+    static bool parseToken(string_view token, uint64_t &id, uint8_t *secret)
+    {
+        uint8_t idBytes[ID_SIZE];
+        if (token.size() != TOKEN_LENGTH || !PasswordHash::fromHex(token, 0, ID_SIZE, idBytes) ||
+            !PasswordHash::fromHex(token, 2 * ID_SIZE, SECRET_SIZE, secret))
+            return false;
+        memcpy(&id, idBytes, sizeof(id));
+        return true;
+    }
+
+    // The live session behind a token (its ID goes to 'id'), or nullptr
+    // (call with 'lock' held)
+    Entry *sessionFor(string_view token, Clock::time_point now, uint64_t &id)
+    {
+        uint8_t secret[SECRET_SIZE];
+        if (!parseToken(token, id, secret))
+            return nullptr;
+
+        auto it = sessions.find(id);
+        if (it == sessions.end() || !PasswordHash::constantTimeEquals(it->second.secret.data(), secret, SECRET_SIZE))
+            return nullptr;
+        if (now - it->second.lastUsed > idleTimeout)
+        {
+            sessions.erase(it);
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    size_t expireIdleLocked(Clock::time_point now)
+    {
+        size_t expired = 0;
+        for (auto it = sessions.begin(); it != sessions.end();)
+        {
+            if (now - it->second.lastUsed > idleTimeout)
+            {
+                it = sessions.erase(it);
+                expired++;
+            }
+            else
+                ++it;
+        }
+        return expired;
+    }
+
+public:
+    explicit SessionManager(const GymEngine &gymEngine, Clock::duration idle = DEFAULT_IDLE_TIMEOUT)
+        : engine(gymEngine), idleTimeout(idle) {}
+
+    SessionManager(const SessionManager &) = delete;
+    SessionManager &operator=(const SessionManager &) = delete;
+
+    // Check the credentials and open a session; the value is its token and
+    // 'session' (optional) receives who it belongs to
+    EngineResult<string> login(const string &email, const string &password, AdminSession *session = nullptr)
+    {
+        EngineResult<string> admin = engine.authenticate(email, password); // Slow part, not under 'lock'
+        if (!admin.ok())
+            return {admin.status, string()};
+
+        uint8_t secret[SECRET_SIZE];
+        PasswordHash::randomBytes(secret, sizeof(secret));
+
+        lock_guard<mutex> guard(lock);
+        Clock::time_point now = Clock::now();
+        if (++loginsSinceSweep >= SWEEP_EVERY)
+        {
+            expireIdleLocked(now);
+            loginsSinceSweep = 0;
+        }
+
+        uint64_t id = 0;
+        do
+            PasswordHash::randomBytes((uint8_t *)&id, sizeof(id));
+        while (sessions.count(id) > 0);
+
+        Entry &entry = sessions[id];
+        memcpy(entry.secret.data(), secret, SECRET_SIZE);
+        entry.admin = {email, std::move(admin.value)};
+        entry.lastUsed = now;
+        if (session != nullptr)
+            *session = entry.admin;
+
+        uint8_t idBytes[ID_SIZE];
+        memcpy(idBytes, &id, sizeof(id));
+        return {EngineStatus::Ok, PasswordHash::toHex(idBytes, ID_SIZE) + PasswordHash::toHex(secret, SECRET_SIZE)};
+    }
+
+    // Is this token a live session? Counts as use (restarts its idle time);
+    // 'session' (optional) receives who it belongs to.
+    bool validate(string_view token, AdminSession *session = nullptr)
+    {
+        lock_guard<mutex> guard(lock);
+        Clock::time_point now = Clock::now();
+        uint64_t id;
+        Entry *entry = sessionFor(token, now, id);
+        if (entry == nullptr)
+            return false;
+        entry->lastUsed = now;
+        if (session != nullptr)
+            *session = entry->admin;
+        return true;
+    }
+
+    // End a session (false if the token was not live)
+    bool logout(string_view token)
+    {
+        lock_guard<mutex> guard(lock);
+        uint64_t id = 0;
+        if (sessionFor(token, Clock::now(), id) == nullptr)
+            return false;
+        sessions.erase(id);
+        return true;
+    }
+
+    // Drop every session idle for too long; returns how many
+    size_t expireIdle()
+    {
+        lock_guard<mutex> guard(lock);
+        return expireIdleLocked(Clock::now());
+    }
+
+    size_t activeCount() const
+    {
+        lock_guard<mutex> guard(lock);
+        return sessions.size();
+    }
+};
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef DATE_H
+#define DATE_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// Date - compact calendar date (days since 1970-01-01 in an int32)
+// Comparing, sorting and range checks are plain integer operations;
+// "YYYY-MM-DD" parsing / formatting is constexpr and allocation free.
+class Date
+{
+private:
+    int32_t days; // Days since 1970-01-01 (negative before)
+
+    // Civil <-> days conversions (proleptic Gregorian calendar)
+    static constexpr int32_t daysFromCivil(int year, int month, int day)
+    {
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const int yoe = year - era * 400;
+        const int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    static constexpr bool isLeapYear(int year)
+    {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    static constexpr int daysInMonth(int year, int month)
+    {
+        return month == 2 ? (isLeapYear(year) ? 29 : 28)
+                          : (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+    }
+
+public:
+    static const size_t TEXT_LENGTH = 10; // "YYYY-MM-DD"
+
+    constexpr Date() : days(0) {}
+    constexpr explicit Date(int32_t daysSinceEpoch) : days(daysSinceEpoch) {}
+
+    // Build from year / month / day (no validation, see isValid)
+    static constexpr Date fromYmd(int year, int month, int day)
+    {
+        return Date(daysFromCivil(year, month, day));
+    }
+
+    static constexpr bool isValid(int year, int month, int day)
+    {
+        return year >= 1 && year <= 9999 && month >= 1 && month <= 12 && day >= 1 && day <= daysInMonth(year, month);
+    }
+
+    // Parse "YYYY-MM-DD" (returns false and leaves 'out' untouched on bad input)
+    static constexpr bool parse(string_view text, Date &out)
+    {
+        if (text.size() != TEXT_LENGTH || text[4] != '-' || text[7] != '-')
+            return false;
+
+        int parts[3] = {0, 0, 0};
+        const size_t starts[3] = {0, 5, 8};
+        const size_t lengths[3] = {4, 2, 2};
+        for (int p = 0; p < 3; p++)
+        {
+            for (size_t i = starts[p]; i < starts[p] + lengths[p]; i++)
+            {
+                if (text[i] < '0' || text[i] > '9')
+                    return false;
+                parts[p] = parts[p] * 10 + (text[i] - '0');
+            }
+        }
+
+        if (!isValid(parts[0], parts[1], parts[2]))
+            return false;
+
+        out = fromYmd(parts[0], parts[1], parts[2]);
+        return true;
+    }
+
+    // Today's local date. The local time is converted at most once per day
+    // (per thread), not per call.
+    static Date today()
+    {
+        static thread_local time_t validUntil = 0;
+        static thread_local Date cached;
+
+        time_t now = time(0);
+        if (now >= validUntil)
+        {
+            tm local;
+#ifdef _WIN32
+            localtime_s(&local, &now);
+#else
+            localtime_r(&now, &local);
+#endif
+            tm *ltm = &local;
+            cached = fromYmd(1900 + ltm->tm_year, 1 + ltm->tm_mon, ltm->tm_mday);
+
+            // Recompute after local midnight
+            int secondsToday = ltm->tm_hour * 3600 + ltm->tm_min * 60 + ltm->tm_sec;
+            validUntil = now + (86400 - secondsToday);
+        }
+        return cached;
+    }
+
+    // Days -> year / month / day
+    constexpr void toYmd(int &year, int &month, int &day) const
+    {
+        const int32_t z = days + 719468;
+        const int era = (z >= 0 ? z : z - 146096) / 146097;
+        const int doe = z - era * 146097;
+        const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int mp = (5 * doy + 2) / 153;
+
+        day = doy - (153 * mp + 2) / 5 + 1;
+        month = mp < 10 ? mp + 3 : mp - 9;
+        year = yoe + era * 400 + (month <= 2);
+    }
+
+    // Write "YYYY-MM-DD" into out[0..9] (no terminator)
+    constexpr void format(char *out) const
+    {
+        int year = 0, month = 0, day = 0;
+        toYmd(year, month, day);
+
+        out[0] = (char)('0' + year / 1000 % 10);
+        out[1] = (char)('0' + year / 100 % 10);
+        out[2] = (char)('0' + year / 10 % 10);
+        out[3] = (char)('0' + year % 10);
+        out[4] = '-';
+        out[5] = (char)('0' + month / 10);
+        out[6] = (char)('0' + month % 10);
+        out[7] = '-';
+        out[8] = (char)('0' + day / 10);
+        out[9] = (char)('0' + day % 10);
+    }
+
+    string toString() const
+    {
+        char buffer[TEXT_LENGTH];
+        format(buffer);
+        return string(buffer, TEXT_LENGTH);
+    }
+
+    // Getters
+    constexpr int32_t daysSinceEpoch() const { return days; }
+
+    constexpr int year() const
+    {
+        int y = 0, m = 0, d = 0;
+        toYmd(y, m, d);
+        return y;
+    }
+
+    // Months since year 0 (handy as a "year-month" bucket key)
+    constexpr int monthKey() const
+    {
+        int y = 0, m = 0, d = 0;
+        toYmd(y, m, d);
+        return y * 12 + (m - 1);
+    }
+
+    // Arithmetic / comparison
+    constexpr Date addDays(int32_t count) const { return Date(days + count); }
+    constexpr int32_t operator-(Date other) const { return days - other.days; }
+
+    constexpr bool operator==(Date other) const { return days == other.days; }
+    constexpr bool operator!=(Date other) const { return days != other.days; }
+    constexpr bool operator<(Date other) const { return days < other.days; }
+    constexpr bool operator<=(Date other) const { return days <= other.days; }
+    constexpr bool operator>(Date other) const { return days > other.days; }
+    constexpr bool operator>=(Date other) const { return days >= other.days; }
+};
+
+static_assert(Date::fromYmd(1970, 1, 1).daysSinceEpoch() == 0, "Date epoch");
+static_assert(Date::fromYmd(2024, 3, 1) - Date::fromYmd(2024, 2, 28) == 2, "Date leap year");
+
+#endif
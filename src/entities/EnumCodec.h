@@ -0,0 +1,111 @@
+#ifndef ENUM_CODEC_H
+#define ENUM_CODEC_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using namespace std;
+
+// One accepted spelling of an enum value ("prem" -> Premium)
+template <typename E>
+struct EnumAlias
+{
+    string_view alias; // Lower-case
+    E value;
+};
+
+// EnumCodec - compile-time perfect-hash parser for enum aliases
+// The constructor searches for a hash seed that puts every alias in its own
+// slot, so parse() is one hash + one string compare, case-insensitive and
+// allocation free. E must have an 'Unknown' value (returned on no match).
+template <typename E, size_t ALIASES, size_t SLOTS>
+class EnumCodec
+{
+    static_assert((SLOTS & (SLOTS - 1)) == 0, "EnumCodec: SLOTS must be a power of two");
+    static_assert(SLOTS >= ALIASES, "EnumCodec: not enough slots for the aliases");
+
+private:
+    struct Entry
+    {
+        string_view alias;
+        E value = E::Unknown;
+        bool used = false;
+    };
+
+    array<Entry, SLOTS> table{};
+    uint32_t seed = 0;
+    size_t longestAlias = 0;
+    bool perfect = false;
+
+    static constexpr char lower(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
+
+    static constexpr uint32_t hash(string_view text, uint32_t hashSeed)
+    {
+        uint32_t h = 2166136261u ^ (hashSeed * 0x9E3779B9u); // FNV-1a
+        for (char c : text)
+        {
+            h ^= (uint8_t)lower(c);
+            h *= 16777619u;
+        }
+        return h ^ (h >> 15);
+    }
+
+    constexpr bool tryBuild(const array<EnumAlias<E>, ALIASES> &aliases, uint32_t hashSeed)
+    {
+        table = array<Entry, SLOTS>{};
+        for (const EnumAlias<E> &entry : aliases)
+        {
+            Entry &slot = table[hash(entry.alias, hashSeed) & (SLOTS - 1)];
+            if (slot.used)
+                return false; // Collision, try the next seed
+            slot.alias = entry.alias;
+            slot.value = entry.value;
+            slot.used = true;
+        }
+        return true;
+    }
+
+public:
+    constexpr explicit EnumCodec(const array<EnumAlias<E>, ALIASES> &aliases)
+    {
+        for (const EnumAlias<E> &entry : aliases)
+            longestAlias = entry.alias.size() > longestAlias ? entry.alias.size() : longestAlias;
+
+        for (uint32_t candidate = 0; candidate < 4096 && !perfect; candidate++)
+        {
+            if (tryBuild(aliases, candidate))
+            {
+                seed = candidate;
+                perfect = true;
+            }
+        }
+    }
+
+    // True when every alias got its own slot (checked with static_assert)
+    constexpr bool isPerfect() const { return perfect; }
+
+    // Alias -> value (case-insensitive), E::Unknown when nothing matches
+    constexpr E parse(string_view text) const
+    {
+        if (text.empty() || text.size() > longestAlias)
+            return E::Unknown;
+
+        const Entry &slot = table[hash(text, seed) & (SLOTS - 1)];
+        if (!slot.used || slot.alias.size() != text.size())
+            return E::Unknown;
+
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            if (lower(text[i]) != slot.alias[i])
+                return E::Unknown;
+        }
+        return slot.value;
+    }
+};
+
+#endif
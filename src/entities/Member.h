@@ -2,77 +2,56 @@
 #define MEMBER_H
 
 #include "User.h"
-#include <ctime>
+#include "Date.h"
+#include "Subscription.h"
 #include <string>
+#include <string_view>
 
 class Member : public User
 {
-    string joinDate;
-    int subscriptionId; // 1 = Standard, 2 = Premium
-    
-    inline static int nextMemberId = 0;
-    inline static bool loadingFromDB = false;
+    Date joinDate;
+    SubscriptionType subscription; // Standard / Premium
 
     // TODO [V2.0]: Implement Loyalty Points System
     // int accessPoints; 
     // vector<Transaction> paymentHistory;
 
-    string getCurrentDate()
-    {
-        time_t now = time(0);
-        tm *ltm = localtime(&now);
-
-        string year = to_string(1900 + ltm->tm_year);
-        string month = to_string(1 + ltm->tm_mon);
-        string day = to_string(ltm->tm_mday);
-
-        // Add leading '0' for months/days -----> "5" -> "05"
-        if (month.length() == 1)
-            month = "0" + month;
-        if (day.length() == 1)
-            day = "0" + day;
-
-        return year + "-" + month + "-" + day;
-    }
-
 public:
+    // IDs come from the engine's IdAllocator (see core/IdAllocator.h)
+
     // Automatic Join Date Assignment
-    Member(string memberName, string memberEmail, string memberPassword)
-        : User(memberName, memberEmail, memberPassword)
+    Member(int memberId, string memberName, string memberEmail, string memberPassword)
+        : User(memberId, std::move(memberName), std::move(memberEmail), std::move(memberPassword))
     {
-        joinDate = getCurrentDate();
-        subscriptionId = 0;
-        
-        if (!loadingFromDB) {
-            nextMemberId++;
-            id = nextMemberId;
-        }
+        joinDate = Date::today();
+        subscription = SubscriptionType::Unknown;
     }
 
     // Manual Join Date Assignment (For Backdating)
-    Member(string memberName, string memberEmail, string memberPassword, string specificDate)
-        : User(memberName, memberEmail, memberPassword)
+    Member(int memberId, string memberName, string memberEmail, string memberPassword, Date specificDate)
+        : User(memberId, std::move(memberName), std::move(memberEmail), std::move(memberPassword))
     {
         joinDate = specificDate;
-        subscriptionId = 0;
-        
-        if (!loadingFromDB) {
-            nextMemberId++;
-            id = nextMemberId;
-        }
+        subscription = SubscriptionType::Unknown;
+    }
+
+    // Manual Join Date Assignment from "YYYY-MM-DD" (falls back to today if malformed)
+    Member(int memberId, string memberName, string memberEmail, string memberPassword, const string &specificDate)
+        : User(memberId, std::move(memberName), std::move(memberEmail), std::move(memberPassword))
+    {
+        if (!Date::parse(specificDate, joinDate))
+            joinDate = Date::today();
+        subscription = SubscriptionType::Unknown;
     }
 
     // Getters
-    int getSubscriptionId() const {return subscriptionId;}
-    string getSubscriptionType() const {return subscriptionId == 1 ? "Standard" : "Premium";}
-    string getJoinDate() const { return joinDate;}
-    
-    // Static ID management
-    static void setNextMemberId(int lastId) { nextMemberId = lastId; }
-    static void setLoadingMode(bool loading) { loadingFromDB = loading; }
+    int getSubscriptionId() const { return (int)subscription; }
+    SubscriptionType getSubscriptionType() const { return subscription; }
+    string_view getSubscriptionName() const { return subscriptionTypeName(subscription); }
+    Date getJoinDate() const { return joinDate; }
 
     // Setters
-    void setSubscriptionId(int subscId) { subscriptionId = subscId; }
+    void setSubscriptionType(SubscriptionType type) { subscription = type; }
 };
 
 #endif
\ No newline at end of file
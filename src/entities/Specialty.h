@@ -0,0 +1,57 @@
+#ifndef SPECIALTY_H
+#define SPECIALTY_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "EnumCodec.h"
+
+using namespace std;
+
+// Trainer specialties
+// To add a specialty: add the value, its name and its aliases below.
+enum class Specialty : uint8_t
+{
+    Unknown = 0,
+    Cardio = 1,
+    StrengthTraining = 2,
+    Yoga = 3
+};
+
+const size_t SPECIALTY_COUNT = 4; // Including Unknown
+
+// Display names, indexed by the enum value
+constexpr string_view SPECIALTY_NAMES[SPECIALTY_COUNT] = {"Unknown", "Cardio", "Strength Training", "Yoga"};
+
+// Accepted user inputs
+constexpr EnumCodec<Specialty, 10, 32> SPECIALTY_CODEC(array<EnumAlias<Specialty>, 10>{{
+    {"cardio", Specialty::Cardio},
+    {"c", Specialty::Cardio},
+    {"1", Specialty::Cardio},
+    {"strength", Specialty::StrengthTraining},
+    {"strength training", Specialty::StrengthTraining},
+    {"s", Specialty::StrengthTraining},
+    {"2", Specialty::StrengthTraining},
+    {"yoga", Specialty::Yoga},
+    {"y", Specialty::Yoga},
+    {"3", Specialty::Yoga},
+}});
+
+static_assert(SPECIALTY_CODEC.isPerfect(), "Specialty aliases need a bigger hash table");
+
+constexpr string_view SPECIALTY_ALIASES_HELP = "Cardio (c, 1), Strength (s, 2), Yoga (y, 3)";
+
+// "Strength Training" -> Specialty::StrengthTraining (Unknown if not recognised)
+constexpr Specialty parseSpecialty(string_view text)
+{
+    return SPECIALTY_CODEC.parse(text);
+}
+
+constexpr string_view specialtyName(Specialty specialty)
+{
+    return (size_t)specialty < SPECIALTY_COUNT ? SPECIALTY_NAMES[(size_t)specialty] : SPECIALTY_NAMES[0];
+}
+
+static_assert(parseSpecialty("Strength Training") == Specialty::StrengthTraining, "Specialty aliases");
+
+#endif
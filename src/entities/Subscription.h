@@ -0,0 +1,54 @@
+#ifndef SUBSCRIPTION_H
+#define SUBSCRIPTION_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "EnumCodec.h"
+
+using namespace std;
+
+// Subscription tiers (the numeric value is the stored subscription ID)
+// To add a tier: add the value, its name and its aliases below.
+enum class SubscriptionType : uint8_t
+{
+    Unknown = 0,
+    Standard = 1,
+    Premium = 2
+};
+
+const size_t SUBSCRIPTION_TYPE_COUNT = 3; // Including Unknown
+
+// Display names, indexed by the enum value
+constexpr string_view SUBSCRIPTION_NAMES[SUBSCRIPTION_TYPE_COUNT] = {"Unknown", "Standard", "Premium"};
+
+// Accepted user inputs
+constexpr EnumCodec<SubscriptionType, 8, 16> SUBSCRIPTION_CODEC(array<EnumAlias<SubscriptionType>, 8>{{
+    {"standard", SubscriptionType::Standard},
+    {"std", SubscriptionType::Standard},
+    {"s", SubscriptionType::Standard},
+    {"1", SubscriptionType::Standard},
+    {"premium", SubscriptionType::Premium},
+    {"prem", SubscriptionType::Premium},
+    {"p", SubscriptionType::Premium},
+    {"2", SubscriptionType::Premium},
+}});
+
+static_assert(SUBSCRIPTION_CODEC.isPerfect(), "Subscription aliases need a bigger hash table");
+
+constexpr string_view SUBSCRIPTION_ALIASES_HELP = "Standard (s, std, 1), Premium (p, prem, 2)";
+
+// "prem" -> SubscriptionType::Premium (Unknown if not recognised)
+constexpr SubscriptionType parseSubscriptionType(string_view text)
+{
+    return SUBSCRIPTION_CODEC.parse(text);
+}
+
+constexpr string_view subscriptionTypeName(SubscriptionType type)
+{
+    return (size_t)type < SUBSCRIPTION_TYPE_COUNT ? SUBSCRIPTION_NAMES[(size_t)type] : SUBSCRIPTION_NAMES[0];
+}
+
+static_assert(parseSubscriptionType("PREM") == SubscriptionType::Premium, "Subscription aliases");
+
+#endif
@@ -1,40 +1,94 @@
 #ifndef SYSTEM_H
 #define SYSTEM_H
 
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "../core/GymEngine.h"
+#include "../core/SessionManager.h"
 #include "../services/ConsoleUI.h"
 #include "../entities/Admin.h"
 #include "../entities/Member.h"
 #include "../entities/Trainer.h"
 #include "../services/AdminService.h"
+#include "../services/BatchService.h"
+#include "../services/ExportService.h"
+#include "../services/ImportService.h"
 #include "../services/MemberService.h"
+#include "../services/PersistenceService.h"
 #include "../services/TrainerService.h"
 
+#ifdef __linux__
+#include <csignal>
+#include "../services/ServerService.h"
+#endif
+
 using namespace std;
 
 class System
 {
 private:
-    Admin *currentAdmin;           // Nullable admin pointer
+    GymEngine engine;              // Owns all data (declared first: services refer to it)
+    SessionManager sessions;       // Logged-in admins (this console and server clients)
+    string sessionToken;           // This console's session (empty = logged out)
     AdminService adminService;     // Service for admins
     MemberService memberService;   // Service for members
     TrainerService trainerService; // Service for trainers
+    PersistenceService persistence; // Snapshot save / load
+    BatchService batchService;      // Scripted commands (no menus)
+    ImportService importService;    // CSV / JSON-lines bulk import
 
 public:
     // Constructor
-    System() : currentAdmin(nullptr){}
+    System(string snapshotPath = PersistenceService::DEFAULT_SNAPSHOT_PATH)
+        : sessions(engine), adminService(sessions), memberService(engine), trainerService(engine),
+          persistence(engine, snapshotPath), batchService(engine, &persistence),
+          importService(engine, &persistence)
+    {
+        loadData();
+    }
 
     // Destructor
-    ~System()
+    ~System() {}
+
+    // ==================== PERSISTENCE ====================
+
+    // Restore the last saved snapshot (if any)
+    // A failure is reported on cerr (no key press: this also runs before the
+    // batch / import / export / server modes); see dataLoaded().
+    bool loadData()
+    {
+        string error;
+        if (!persistence.load(error))
+        {
+            cerr << "Could not load saved data: " << error << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // The saved data was restored; when false, nothing may run (a save would
+    // overwrite the files that failed to load, so PersistenceService refuses it)
+    bool dataLoaded() const
     {
-        if (currentAdmin != nullptr)
+        return persistence.isLoaded();
+    }
+
+    // Save everything to the snapshot file
+    bool saveData()
+    {
+        string error;
+        if (!persistence.save(error))
         {
-            delete currentAdmin;
-            currentAdmin = nullptr;
+            ConsoleUI::printError("Could not save data: " + error);
+            ConsoleUI::pause();
+            return false;
         }
+        return true;
     }
 
     // ==================== AUTHENTICATION ====================
@@ -42,31 +96,30 @@ public:
     // Login function
     bool login()
     {
-        currentAdmin = adminService.login();
-        return currentAdmin != nullptr;
+        sessionToken = adminService.login();
+        return !sessionToken.empty();
     }
 
     // Logout function
     void logout()
     {
-        adminService.logout(currentAdmin);
-        if (currentAdmin != nullptr)
-        {
-            delete currentAdmin;
-            currentAdmin = nullptr;
-        }
+        adminService.logout(sessionToken);
+        sessionToken.clear();
     }
 
-    // Check if admin is logged in
-    bool isLoggedIn() const
+    // Check if admin is logged in (an idle session expires)
+    bool isLoggedIn()
     {
-        return currentAdmin != nullptr;
+        return sessions.validate(sessionToken);
     }
 
-    // Get current admin
-    Admin *getCurrentAdmin() const
+    // Get current admin (owned by the engine, nullptr if logged out)
+    Admin *getCurrentAdmin()
     {
-        return currentAdmin;
+        AdminSession admin;
+        if (!sessions.validate(sessionToken, &admin))
+            return nullptr;
+        return engine.findAdminByEmail(admin.email);
     }
 
     // ==================== MEMBER CRUD ====================
@@ -118,7 +171,7 @@ public:
     // Update - Update trainer information
     void updateTrainer()
     {
-        trainerService.updateTrainer(memberService.getAllMembers());
+        trainerService.updateTrainer();
     }
 
     // Delete - Remove a trainer
@@ -138,6 +191,8 @@ public:
             vector<string> opts = {
                 "Add New Member",
                 "View All Members",
+                "Filter Members by Subscription",
+                "Filter Members by Join Date",
                 "Update Member",
                 "Delete Member",
                 "Back to Dashboard"};
@@ -150,9 +205,11 @@ public:
             switch (choice) {
                 case 0: memberService.addMember(); break;
                 case 1: memberService.viewAllMembers(); break;
-                case 2: memberService.updateMember(); break;
-                case 3: memberService.deleteMember(); break;
-                case 4: return;
+                case 2: memberService.viewMembersBySubscription(); break;
+                case 3: memberService.viewMembersByJoinDate(); break;
+                case 4: memberService.updateMember(); break;
+                case 5: memberService.deleteMember(); break;
+                case 6: return;
             }
         }
     }
@@ -179,18 +236,249 @@ public:
                 case 0: trainerService.addTrainer(); break;
                 case 1: trainerService.viewAllTrainers(); break;
                 case 2: trainerService.viewAssignedMembers(); break;
-                case 3: trainerService.updateTrainer(memberService.getAllMembers()); break;
+                case 3: trainerService.updateTrainer(); break;
                 case 4: trainerService.deleteTrainer(); break;
                 case 5: return;
             }
         }
     }
 
+    // Dashboard figures (read from counters kept by the services, O(1))
+    string dashboardStats()
+    {
+        GymEngine::ReadGuard guard = engine.readLock();
+        const MemberAggregates &members = engine.getMemberStats();
+        const TrainerLoadHistogram &load = engine.getTrainerLoad();
+        Date today = Date::today();
+        int year = 0, month = 0, day = 0;
+        today.toYmd(year, month, day);
+        Date lastMonth = Date::fromYmd(year, month, 1).addDays(-1);
+
+        ostringstream out;
+        out << " Members:  " << members.totalMembers()
+            << "  (Standard " << members.membersWith(SubscriptionType::Standard)
+            << " | Premium " << members.membersWith(SubscriptionType::Premium) << ")\n";
+        out << " Joined:   " << members.joinsInMonthOf(today) << " this month, "
+            << members.joinsInMonthOf(lastMonth) << " last month\n";
+        out << " Trainers: " << load.totalTrainers() << "  (" << load.totalAssignments()
+            << " assignments, avg " << fixed << setprecision(1) << load.averageLoad()
+            << " / " << Trainer::MAX_ASSIGNED_MEMBERS << ")\n";
+        out << " Load:    ";
+        for (size_t assigned = 0; assigned < TrainerLoadHistogram::BUCKETS; assigned++)
+            out << " " << assigned << ":" << load.trainersWith(assigned);
+        out << "\n";
+        return out.str();
+    }
+
+    // ==================== BATCH MODE ====================
+
+    // Run a command script ('-' = stdin) instead of the menus
+    // Results go to stdout, the summary to stderr. Returns the process exit
+    // code: 0 = all commands succeeded, 1 = some failed, 2 = unreadable script.
+    int runBatch(const string &source)
+    {
+        BatchSummary summary;
+        if (source == "-")
+        {
+            ios::sync_with_stdio(false);
+            summary = batchService.run(cin, cout);
+        }
+        else
+        {
+            ifstream script(source);
+            if (!script)
+            {
+                cerr << "Cannot open batch script " << source << endl;
+                return 2;
+            }
+            summary = batchService.run(script, cout);
+        }
+
+        cerr << "# " << summary.commands << " commands, " << summary.failed << " failed, "
+             << fixed << setprecision(3) << summary.seconds << " s ("
+             << setprecision(0) << summary.commandsPerSecond() << " commands/s)" << endl;
+        return summary.failed == 0 ? 0 : 1;
+    }
+
+    // ==================== BULK IMPORT ====================
+
+    // Import members or trainers from a CSV / JSON-lines file
+    // Rejected rows go to stdout ("<line> ERR <reason>"), the summary to stderr.
+    // Returns the exit code: 0 = all rows imported, 1 = some rejected, 2 = failed.
+    int runImport(const string &kind, const string &path)
+    {
+        if (kind != "members" && kind != "trainers")
+        {
+            cerr << "Import what? Use 'members' or 'trainers'" << endl;
+            return 2;
+        }
+
+        ImportSummary summary;
+        string error;
+        if (!importService.importFile(kind == "members" ? ImportKind::Members : ImportKind::Trainers, path,
+                                      summary, error))
+        {
+            cerr << error << endl;
+            return 2;
+        }
+
+        string report;
+        for (const ImportError &rejected : summary.errors)
+            report += to_string(rejected.line) + " ERR " + rejected.message + "\n";
+        cout << report << flush;
+
+        cerr << "# " << summary.imported << " of " << summary.rows << " rows imported, " << summary.rejected()
+             << " rejected, " << fixed << setprecision(3) << summary.seconds << " s (" << setprecision(0)
+             << summary.rowsPerSecond() << " rows/s)" << endl;
+        return summary.rejected() == 0 ? 0 : 1;
+    }
+
+    // ==================== EXPORT ====================
+
+    // Export members / trainers / assignments:
+    //   <members | trainers | assignments> <file | -> [--format csv|json]
+    //   [--columns a,b,c] [--where <column><op><value>]...
+    // The format defaults to JSON lines for .json / .jsonl files, CSV otherwise.
+    // Returns the exit code: 0 = written, 2 = bad arguments / write error.
+    int runExport(const vector<string> &args)
+    {
+        ExportOptions options;
+        string error;
+
+        if (args.size() < 2)
+        {
+            cerr << "Usage: --export <members | trainers | assignments> <file | -> [--format csv|json] "
+                    "[--columns a,b] [--where <column><op><value>]"
+                 << endl;
+            return 2;
+        }
+
+        const string &what = args[0];
+        if (what == "members")
+            options.dataset = ExportDataset::Members;
+        else if (what == "trainers")
+            options.dataset = ExportDataset::Trainers;
+        else if (what == "assignments")
+            options.dataset = ExportDataset::Assignments;
+        else
+        {
+            cerr << "Export what? Use 'members', 'trainers' or 'assignments'" << endl;
+            return 2;
+        }
+
+        const string &path = args[1];
+        bool json = path.size() >= 5 && (path.compare(path.size() - 5, 5, ".json") == 0 ||
+                                         (path.size() >= 6 && path.compare(path.size() - 6, 6, ".jsonl") == 0));
+        options.format = json ? ExportFormat::JsonLines : ExportFormat::Csv;
+
+        for (size_t i = 2; i < args.size(); i++)
+        {
+            bool hasValue = i + 1 < args.size();
+            if (args[i] == "--format" && hasValue)
+            {
+                const string &format = args[++i];
+                if (format != "csv" && format != "json")
+                    error = "Unknown format '" + format + "' (csv or json)";
+                options.format = format == "json" ? ExportFormat::JsonLines : ExportFormat::Csv;
+            }
+            else if (args[i] == "--columns" && hasValue)
+                ExportService::parseColumns(options.dataset, args[++i], options.columns, error);
+            else if (args[i] == "--where" && hasValue)
+            {
+                ExportFilter filter;
+                if (ExportService::parseFilter(options.dataset, args[++i], filter, error))
+                    options.where.push_back(std::move(filter));
+            }
+            else
+                error = "Unknown option '" + args[i] + "'";
+
+            if (!error.empty())
+            {
+                cerr << error << endl;
+                return 2;
+            }
+        }
+
+        FILE *file = path == "-" ? stdout : fopen(path.c_str(), "wb");
+        if (file == nullptr)
+        {
+            cerr << "Cannot create " << path << endl;
+            return 2;
+        }
+
+        auto started = chrono::steady_clock::now();
+        bool ok = false;
+        size_t rows = ExportService(engine).exportTo(file, options, ok);
+        if (file != stdout && fclose(file) != 0)
+            ok = false;
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+
+        if (!ok)
+        {
+            cerr << "Could not write " << path << endl;
+            return 2;
+        }
+        cerr << "# " << rows << " rows exported in " << fixed << setprecision(3) << seconds << " s" << endl;
+        return 0;
+    }
+
+    // ==================== SERVER MODE ====================
+
+#ifdef __linux__
+    // Serve the engine to many desks at 'address' until Ctrl+C / SIGTERM,
+    // then save a snapshot. Returns the exit code (0 = clean stop, 2 = failed).
+    int runServer(const string &address)
+    {
+        static ServerService *running = nullptr; // For the signal handler
+
+        ServerService server(sessions, batchService, &persistence);
+        string error;
+        if (!server.start(address, error))
+        {
+            cerr << error << endl;
+            return 2;
+        }
+
+        running = &server;
+        auto onSignal = [](int) { running->stop(); };
+        signal(SIGINT, onSignal);
+        signal(SIGTERM, onSignal);
+        cerr << "# Serving on " << server.boundAddress() << " (Ctrl+C to stop)" << endl;
+
+        bool served = server.serve(error);
+        signal(SIGINT, SIG_DFL);
+        signal(SIGTERM, SIG_DFL);
+        running = nullptr;
+
+        const ServerStats &stats = server.getStats();
+        cerr << "# " << stats.connections << " connections, " << stats.requests << " requests, "
+             << stats.failed << " failed" << endl;
+        if (!served)
+        {
+            cerr << error << endl;
+            return 2;
+        }
+        if (!persistence.save(error))
+        {
+            cerr << "Could not save data: " << error << endl;
+            return 2;
+        }
+        return 0;
+    }
+#endif
+
     // Run the application
     void run()
     {
         while (true)
         {
+            // No keyboard left (stdin closed): save and stop instead of spinning
+            if (ConsoleUI::inputClosed())
+            {
+                saveData();
+                return;
+            }
+
             // Check if we need to show the "Welcome/Login" screen
             if (!isLoggedIn())
             {
@@ -223,6 +511,7 @@ public:
                 }
                 else
                 {
+                    saveData();
                     return; // Exit the program
                 }
             }
@@ -235,7 +524,7 @@ public:
                     "Logout"};
 
                 // get menu choice here
-                int choice = ConsoleUI::getMenuSelection("MAIN DASHBOARD", mainOptions);
+                int choice = ConsoleUI::getMenuSelection("MAIN DASHBOARD", mainOptions, dashboardStats());
 
                 // Handle selection (Index 0, 1, 2)
                 switch (choice)
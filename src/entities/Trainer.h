@@ -3,76 +3,61 @@
 
 #include "User.h"
 #include "Member.h"
+#include "Specialty.h"
+#include "../storage/SlotMap.h"
+#include "../storage/Span.h"
+#include <string_view>
 #include <vector>
 
 class Trainer : public User
 {
-    string specialty;
-    vector<Member *> assignedMembers;
-    
-    inline static int nextTrainerId = 0;
-    inline static bool loadingFromDB = false;
+    Specialty specialty;
+    vector<Handle<Member>> assignedMembers; // Handles into GymEngine's member store
 
 public:
-    Trainer(string trainerName, string trainerEmail, string trainerPassword, string trainerSpecialty)
-        : User(trainerName, trainerEmail, trainerPassword)
+    // Each Trainer can have only up to 7 members assigned at a time.
+    static const size_t MAX_ASSIGNED_MEMBERS = 7;
+
+    // The ID comes from the engine's IdAllocator (see core/IdAllocator.h)
+    Trainer(int trainerId, string trainerName, string trainerEmail, string trainerPassword, Specialty trainerSpecialty)
+        : User(trainerId, std::move(trainerName), std::move(trainerEmail), std::move(trainerPassword))
     {
         specialty = trainerSpecialty;
-        
-        if (!loadingFromDB) {
-            nextTrainerId++;
-            id = nextTrainerId;
-        }
     }
 
     // Getters
-    string getTrainerSpecialty() const { return specialty; }
-    vector<Member *> getAssignedMembers() const { return assignedMembers; }
-    
-    // Static ID management
-    static void setNextTrainerId(int lastId) { nextTrainerId = lastId; }
-    static void setLoadingMode(bool loading) { loadingFromDB = loading; }
+    Specialty getTrainerSpecialty() const { return specialty; }
+    string_view getTrainerSpecialtyName() const { return specialtyName(specialty); }
+    Span<Handle<Member>> getAssignedMembers() const { return assignedMembers; } // View, no copy
+    size_t getAssignedCount() const { return assignedMembers.size(); }
 
     // Setters
-    void setTrainerSpecialty(string trainerSpecialty) { specialty = trainerSpecialty; }
+    void setTrainerSpecialty(Specialty trainerSpecialty) { specialty = trainerSpecialty; }
 
-    void viewAssignedMembers()
+    // Add a member handle (false when the trainer is already full)
+    bool addAssignedMember(Handle<Member> handle)
     {
-        cout << "Trainer " << this->name << " assigned members are:" << endl;
-        for (Member *member : assignedMembers)
-        {
-            cout << "Member ID: " << member->getId() << ", Name: " << member->getName() << endl;
-        }
-    }
+        if (assignedMembers.size() == MAX_ASSIGNED_MEMBERS)
+            return false;
 
-    void assignMember(Member *member)
-    {
-        // Each Trainer can have only up to 7 members assigned at a time.
-        if (assignedMembers.size() == 7)
-        {
-            cout << ">> Trainer can only Manage 7 Members at a time!" << endl;
-        }
-        else
-        {
-            assignedMembers.push_back(member);
-            cout << ">> System: " << member->getName() << " assigned to " << this->name << endl;
-        }
+        assignedMembers.push_back(handle);
+        return true;
     }
 
-    // Remove a member from this trainer's list by ID
-    void removeMember(int memberId)
+    // Remove a member from this trainer's list by handle (silent, returns true if found)
+    bool removeMember(Handle<Member> member)
     {
         for (auto it = assignedMembers.begin(); it != assignedMembers.end(); ++it)
         {
-            if ((*it)->getId() == memberId)
+            if (*it == member)
             {
-                // We only erase the POINTER from this list.
-                // We do NOT 'delete *it' here, because MemberService is about to do that.
-                assignedMembers.erase(it); 
-                cout << ">> System: Member removed from Trainer " << this->name << "'s list." << endl;
-                return;
+                // We only erase the HANDLE from this list.
+                // The member itself is owned (and erased) by GymEngine.
+                assignedMembers.erase(it);
+                return true;
             }
         }
+        return false;
     }
 };
 
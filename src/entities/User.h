@@ -1,6 +1,7 @@
 #ifndef USER_H
 #define USER_H
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 using namespace std;
@@ -12,21 +13,30 @@ protected:
     string name;
     string email;
     string password;
+    uint64_t revision = 0; // Change stamp given by the engine (0 = never stored)
 
 public:
-    User(string userName, string userEmail, string userPassword)
-        : name(userName), email(userEmail), password(userPassword), id(0)
+    User(int userId, string userName, string userEmail, string userPassword)
+        : id(userId), name(std::move(userName)), email(std::move(userEmail)), password(std::move(userPassword))
     {
-        // ID will be set by derived class
     }
 
-    // Getters
+    // Getters (references: reading a user never copies its strings)
     int getId() const { return id; }
-    string getName() const { return name; }
-    string getEmail() const { return email; }
+    const string &getName() const { return name; }
+    const string &getEmail() const { return email; }
+    const string &getPassword() const { return password; } // For persistence only
+    uint64_t getRevision() const { return revision; }
     
     // Setters
     void setId(int newId) { id = newId; }
+    void setRevision(uint64_t stamp) { revision = stamp; }
+
+    // Users are stored by value (see SlotMap), so keep them cheap to move
+    User(const User &) = default;
+    User(User &&) = default;
+    User &operator=(const User &) = default;
+    User &operator=(User &&) = default;
 
     virtual ~User() {}
 };
@@ -1,11 +1,98 @@
+#include <string>
+
 #include "entities/System.h"
 
 using namespace std;
 
-int main() {
-    // Create and run the system
+// Whole-number argument in [minimum, maximum]; prints a usage error otherwise
+static bool parseNumber(const char *text, const char *name, size_t minimum, size_t maximum, size_t &value) {
+    string digits = text;
+    if (digits.empty() || digits.size() > 9 || digits.find_first_not_of("0123456789") != string::npos ||
+        stoul(digits) < minimum || stoul(digits) > maximum) {
+        cerr << "Invalid " << name << " '" << text << "': expected a number from " << minimum << " to " << maximum
+             << endl;
+        return false;
+    }
+    value = stoul(digits);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    // Batch mode: main --batch <script | ->
+    if (argc == 3 && string(argv[1]) == "--batch") {
+        System system;
+        if (!system.dataLoaded()) return 2;
+        return system.runBatch(argv[2]);
+    }
+
+    // Bulk import: main --import <members | trainers> <file.csv | file.jsonl>
+    if (argc == 4 && string(argv[1]) == "--import") {
+        System system;
+        if (!system.dataLoaded()) return 2;
+        return system.runImport(argv[2], argv[3]);
+    }
+
+    // Export: main --export <members | trainers | assignments> <file | -> [options]
+    if (argc >= 4 && string(argv[1]) == "--export") {
+        System system;
+        if (!system.dataLoaded()) return 2;
+        return system.runExport(vector<string>(argv + 2, argv + argc));
+    }
+
+    // Import benchmark: main --import-bench <rows>
+    if (argc == 3 && string(argv[1]) == "--import-bench") {
+        size_t rows;
+        if (!parseNumber(argv[2], "row count", 1, 100000000, rows)) return 2;
+        return ImportService::benchmark(rows, "elforma-import-bench.csv", cerr) ? 0 : 1;
+    }
+
+#ifdef __linux__
+    // Server: main --serve <unix:path | port>
+    if (argc == 3 && string(argv[1]) == "--serve") {
+        System system;
+        if (!system.dataLoaded()) return 2;
+        return system.runServer(argv[2]);
+    }
+
+    // Load generator: main --load <address> [connections] [requests] [pipeline] [write %] [email] [password]
+    if (argc >= 3 && argc <= 9 && string(argv[1]) == "--load") {
+        LoadOptions options;
+        options.address = argv[2];
+        size_t writePercent = (size_t)options.writePercent;
+        if ((argc > 3 && !parseNumber(argv[3], "connection count", 1, 10000, options.connections)) ||
+            (argc > 4 && !parseNumber(argv[4], "request count", 1, 100000000, options.requests)) ||
+            (argc > 5 && !parseNumber(argv[5], "pipeline depth", 1, 10000, options.pipeline)) ||
+            (argc > 6 && !parseNumber(argv[6], "write percentage", 0, 100, writePercent)))
+            return 2;
+        options.writePercent = (int)writePercent;
+        if (argc > 7) options.email = argv[7];
+        if (argc > 8) options.password = argv[8];
+
+        LoadReport report;
+        string error;
+        if (!LoadGenerator::run(options, report, error)) {
+            cerr << error << endl;
+            return 2;
+        }
+        LoadGenerator::print(report, options, cerr);
+        return report.errors == 0 ? 0 : 1;
+    }
+
+    // Server benchmark: main --server-bench [connections] [requests]
+    if (argc >= 2 && argc <= 4 && string(argv[1]) == "--server-bench") {
+        size_t connections = 16;
+        size_t requests = 100000;
+        if ((argc > 2 && !parseNumber(argv[2], "connection count", 1, 10000, connections)) ||
+            (argc > 3 && !parseNumber(argv[3], "request count", 1, 100000000, requests)))
+            return 2;
+        return ServerService::benchmark(connections, requests, cerr) ? 0 : 1;
+    }
+#endif
+
+    // Create and run the system (never on top of data that failed to load)
     System system;
+    if (!system.dataLoaded()) return 2;
     system.run();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,233 @@
+#ifndef SOCKET_H
+#define SOCKET_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Where the server listens / the client connects
+// "unix:<path>" (or any text with a '/') is a Unix domain socket; "<port>",
+// ":<port>", "127.0.0.1:<port>" or "localhost:<port>" is TCP on the loopback
+// interface. Other hosts are refused: the server is for local desks only.
+struct SocketAddress
+{
+    bool local = false; // Unix domain socket
+    string path;        // Socket file (local)
+    uint16_t port = 0;  // TCP port (0 = any free port when listening)
+
+    string toString() const
+    {
+        return local ? "unix:" + path : "127.0.0.1:" + to_string(port);
+    }
+
+    static bool parse(const string &text, SocketAddress &address, string &error)
+    {
+        address = SocketAddress();
+        if (text.rfind("unix:", 0) == 0 || text.find('/') != string::npos)
+        {
+            address.local = true;
+            address.path = text.rfind("unix:", 0) == 0 ? text.substr(5) : text;
+            if (address.path.empty() || address.path.size() >= sizeof(sockaddr_un::sun_path))
+            {
+                error = "Invalid socket path '" + address.path + "'";
+                return false;
+            }
+            return true;
+        }
+
+        string port = text;
+        size_t colon = text.rfind(':');
+        if (colon != string::npos)
+        {
+            string host = text.substr(0, colon);
+            if (!host.empty() && host != "127.0.0.1" && host != "localhost")
+            {
+                error = "Only loopback addresses are allowed (127.0.0.1 / localhost)";
+                return false;
+            }
+            port = text.substr(colon + 1);
+        }
+
+        if (port.empty() || port.size() > 5 || port.find_first_not_of("0123456789") != string::npos ||
+            stoul(port) > 65535)
+        {
+            error = "Invalid port '" + port + "'";
+            return false;
+        }
+        address.port = (uint16_t)stoul(port);
+        return true;
+    }
+};
+
+// Socket - owns one socket descriptor (closed on destruction)
+// A listening Unix socket also owns its socket file, removed when it closes.
+class Socket
+{
+private:
+    int fd = -1;
+    string socketFile; // Unix socket file bound by listenOn (empty = none)
+
+    static bool fail(string &error, const string &what)
+    {
+        error = what + ": " + strerror(errno);
+        return false;
+    }
+
+    static socklen_t fill(const SocketAddress &address, sockaddr_storage &storage)
+    {
+        memset(&storage, 0, sizeof(storage));
+        if (address.local)
+        {
+            sockaddr_un *un = (sockaddr_un *)&storage;
+            un->sun_family = AF_UNIX;
+            memcpy(un->sun_path, address.path.c_str(), address.path.size() + 1);
+            return sizeof(sockaddr_un);
+        }
+
+        sockaddr_in *in = (sockaddr_in *)&storage;
+        in->sin_family = AF_INET;
+        in->sin_port = htons(address.port);
+        in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return sizeof(sockaddr_in);
+    }
+
+public:
+    Socket() {}
+    explicit Socket(int descriptor) : fd(descriptor) {}
+    Socket(const Socket &) = delete;
+    Socket &operator=(const Socket &) = delete;
+    Socket(Socket &&other) noexcept : fd(other.fd), socketFile(std::move(other.socketFile))
+    {
+        other.fd = -1;
+        other.socketFile.clear();
+    }
+    Socket &operator=(Socket &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            fd = other.fd;
+            socketFile = std::move(other.socketFile);
+            other.fd = -1;
+            other.socketFile.clear();
+        }
+        return *this;
+    }
+
+    ~Socket() { close(); }
+
+    int get() const { return fd; }
+    bool isOpen() const { return fd >= 0; }
+
+    void close()
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+        if (!socketFile.empty())
+            unlink(socketFile.c_str());
+        socketFile.clear();
+    }
+
+    bool setNonBlocking()
+    {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    // Send small requests / replies at once instead of waiting to fill a segment
+    void setNoDelay()
+    {
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)); // Fails harmlessly on Unix sockets
+    }
+
+    // Bind + listen; port 0 picks a free port (written back into 'address').
+    // A stale socket file is replaced, but any other file at a Unix socket
+    // path is left alone and refused.
+    bool listenOn(SocketAddress &address, string &error)
+    {
+        close();
+        if (address.local)
+        {
+            struct stat info;
+            if (lstat(address.path.c_str(), &info) == 0)
+            {
+                if (!S_ISSOCK(info.st_mode))
+                {
+                    error = "Cannot listen on " + address.path + ": the file exists and is not a socket";
+                    return false;
+                }
+                if (unlink(address.path.c_str()) != 0)
+                    return fail(error, "Cannot replace " + address.path);
+            }
+            else if (errno != ENOENT)
+                return fail(error, "Cannot check " + address.path);
+        }
+
+        fd = socket(address.local ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+            return fail(error, "Cannot create socket");
+
+        if (!address.local)
+        {
+            int on = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        }
+
+        sockaddr_storage storage;
+        socklen_t length = fill(address, storage);
+        if (bind(fd, (sockaddr *)&storage, length) != 0)
+            return fail(error, "Cannot bind " + address.toString());
+        if (address.local)
+            socketFile = address.path;
+        if (listen(fd, SOMAXCONN) != 0)
+            return fail(error, "Cannot listen on " + address.toString());
+
+        if (!address.local && address.port == 0)
+        {
+            sockaddr_in bound;
+            socklen_t boundLength = sizeof(bound);
+            if (getsockname(fd, (sockaddr *)&bound, &boundLength) == 0)
+                address.port = ntohs(bound.sin_port);
+        }
+        return setNonBlocking() || fail(error, "Cannot configure socket");
+    }
+
+    // Blocking connect
+    bool connectTo(const SocketAddress &address, string &error)
+    {
+        close();
+        fd = socket(address.local ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+            return fail(error, "Cannot create socket");
+
+        sockaddr_storage storage;
+        socklen_t length = fill(address, storage);
+        if (connect(fd, (sockaddr *)&storage, length) != 0)
+            return fail(error, "Cannot connect to " + address.toString());
+        if (!address.local)
+            setNoDelay();
+        return true;
+    }
+
+    // Accept one pending connection (an empty Socket when there is none)
+    Socket acceptOne() const
+    {
+        return Socket(accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC));
+    }
+};
+
+#endif
@@ -5,104 +5,58 @@
 #include <vector>
 #include <string>
 
-#include "../entities/Admin.h"
+#include "../core/SessionManager.h"
 #include "../services/ConsoleUI.h"
 
 using namespace std;
 
-// AdminService class - handles admin operations with UI
+// AdminService class - console front-end for admin operations
+// The admin accounts themselves live in GymEngine, the sessions in SessionManager.
 class AdminService {
 private:
-    static vector<Admin*> admins;
-    static bool initialized;
-    
-    // Initialize with default admin
-    void initialize() {
-        if (!initialized) {
-            // Create default admin
-            admins.push_back(new Admin("Mohamed Rashad", "admin", "123"));
-            initialized = true;
-        }
-    }
+    SessionManager& sessions;
 
 public:
     // Constructor
-    AdminService() {
-        initialize();
-    }
+    explicit AdminService(SessionManager& sessionManager) : sessions(sessionManager) {}
 
-    // Login with UI
-    Admin* login() {
+    // Login with UI, returns the session token (empty if cancelled or failed)
+    string login() {
         // Draw the New Form UI
         vector<string> data = ConsoleUI::getFormData("ADMIN LOGIN", {"Email", "Password"});
         
         // Check if ESC was pressed (Empty return)
-        if (data.empty()) return nullptr;
+        if (data.empty()) return string();
 
         string email = data[0];
         string password = data[1];
 
         // Authentication
-        Admin* admin = authenticate(email, password);
+        EngineResult<string> session = sessions.login(email, password);
         
-        if (admin != nullptr) {
+        if (session.ok()) {
             ConsoleUI::printSuccess("Login successful!");
             ConsoleUI::pause();
-            return admin;
+            return session.value;
         }
         
         ConsoleUI::printError("Invalid email or password!");
         ConsoleUI::pause();
-        return nullptr;
+        return string();
     }
     
     // Logout with UI
-    void logout(Admin* admin) {
-        if (admin != nullptr) {
-            admin->logout();
+    void logout(const string& token) {
+        AdminSession admin;
+        if (sessions.validate(token, &admin)) {
+            sessions.logout(token);
+            ConsoleUI::printInfo("Goodbye, " + admin.name + "!");
             ConsoleUI::printSuccess("Logged out successfully!");
         } else {
             ConsoleUI::printWarning("No user is currently logged in.");
         }
         ConsoleUI::pause();
     }
-    
-    // Authenticate admin (internal use)
-    Admin* authenticate(const string& email, const string& password) {
-        initialize();
-        
-        for (Admin* admin : admins) {
-            if (admin->login(email, password)) {
-                return admin;
-            }
-        }
-        
-        return nullptr;
-    }
-    
-    // Find admin by email (internal use)
-    Admin* findAdminByEmail(const string& email) {
-        initialize();
-        
-        for (Admin* admin : admins) {
-            if (admin->getEmail() == email) {
-                return admin;
-            }
-        }
-        
-        return nullptr;
-    }
-    
-    // Add a new admin
-    bool addAdmin(Admin* admin) {
-        initialize();
-        admins.push_back(admin);
-        return true;
-    }
 };
 
-// Initialize static members
-vector<Admin*> AdminService::admins;
-bool AdminService::initialized = false;
-
 #endif // ADMIN_SERVICE_H
@@ -0,0 +1,559 @@
+#ifndef BATCH_SERVICE_H
+#define BATCH_SERVICE_H
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../core/GymEngine.h"
+#include "../services/PersistenceService.h"
+
+using namespace std;
+
+// What a script line asks for
+enum class BatchOp : uint8_t
+{
+    AddMember,      // add-member <name> <email> <password> <tier> [YYYY-MM-DD]
+    UpdateMember,   // update-member <id> <tier>
+    DeleteMember,   // delete-member <id>
+    AddTrainer,     // add-trainer <name> <email> <password> <specialty>
+    UpdateTrainer,  // update-trainer <id> <specialty>
+    DeleteTrainer,  // delete-trainer <id>
+    Assign,         // assign <trainer id> <member id>
+    FindMember,     // find-member <id | email>
+    FindTrainer,    // find-trainer <id | email>
+    SearchMembers,  // search-members <query>
+    SearchTrainers, // search-trainers <query>
+    JoinedBetween,  // joined-between <YYYY-MM-DD> <YYYY-MM-DD>
+    Stats,          // stats
+    Save,           // save
+    Invalid         // Parse error (see BatchCommand::error)
+};
+
+// One parsed script line, ready to run (no text left to interpret)
+struct BatchCommand
+{
+    size_t line = 0;
+    BatchOp op = BatchOp::Invalid;
+    array<string, 3> text;       // Name / email / password or query
+    int id = 0;                  // Member / trainer ID (-1 = look up text[0] as an email)
+    int otherId = 0;             // Member ID of 'assign'
+    Date from, to;               // Join date / date range
+    SubscriptionType tier = SubscriptionType::Unknown;
+    Specialty specialty = Specialty::Unknown;
+    const char *error = nullptr; // Set when op == Invalid
+};
+
+// Bounded hand-over of parsed commands from the reader thread to the executor
+// Commands travel in batches so the lock is taken once per batch, not per line.
+class BatchQueue
+{
+private:
+    mutex lock;
+    condition_variable notEmpty, notFull;
+    deque<vector<BatchCommand>> batches;
+    size_t capacity;
+    bool closed = false;
+
+public:
+    explicit BatchQueue(size_t maxBatches) : capacity(maxBatches) {}
+
+    void push(vector<BatchCommand> &&batch)
+    {
+        unique_lock<mutex> guard(lock);
+        notFull.wait(guard, [this] { return batches.size() < capacity; });
+        batches.push_back(std::move(batch));
+        notEmpty.notify_one();
+    }
+
+    // No more batches will be pushed
+    void close()
+    {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+    // Next batch (false once the queue is closed and drained)
+    bool pop(vector<BatchCommand> &batch)
+    {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [this] { return !batches.empty() || closed; });
+        if (batches.empty())
+            return false;
+        batch = std::move(batches.front());
+        batches.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+};
+
+// Totals of one batch run
+struct BatchSummary
+{
+    size_t commands = 0;
+    size_t failed = 0;
+    double seconds = 0;
+
+    double commandsPerSecond() const { return seconds > 0 ? commands / seconds : 0; }
+};
+
+// BatchService - runs scripted commands against the engine without the menus
+// Input: one command per line (see BatchOp), fields separated by spaces,
+// "double quotes" around fields that contain spaces, '#' starts a comment.
+// Output: one line per command, "<line> OK [result]" or "<line> ERR <message>".
+//
+// A reader thread streams and parses the script while the calling thread
+// executes, so parsing overlaps with engine work. Log records are group
+// committed for the length of the run, and committed before each block of
+// results is written out.
+class BatchService
+{
+private:
+    GymEngine &engine;
+    PersistenceService *persistence; // nullptr = nothing to save / commit
+
+    static const size_t COMMANDS_PER_BATCH = 512;
+    static const size_t QUEUED_BATCHES = 16;
+    static const size_t OUTPUT_FLUSH_BYTES = 1 << 16;
+    static const size_t GROUP_COMMIT_RECORDS = 4096;
+    static const int GROUP_COMMIT_DELAY_MS = 50;
+    // ---------- Parsing helpers ----------
+
+    static bool parseId(string_view text, int &out)
+    {
+        const char *end = text.data() + text.size();
+        auto result = from_chars(text.data(), end, out);
+        return result.ec == errc() && result.ptr == end && out >= 0;
+    }
+
+    static BatchOp parseOp(string_view name)
+    {
+        static const array<pair<string_view, BatchOp>, 14> OPS = {{
+            {"add-member", BatchOp::AddMember},
+            {"update-member", BatchOp::UpdateMember},
+            {"delete-member", BatchOp::DeleteMember},
+            {"add-trainer", BatchOp::AddTrainer},
+            {"update-trainer", BatchOp::UpdateTrainer},
+            {"delete-trainer", BatchOp::DeleteTrainer},
+            {"assign", BatchOp::Assign},
+            {"find-member", BatchOp::FindMember},
+            {"find-trainer", BatchOp::FindTrainer},
+            {"search-members", BatchOp::SearchMembers},
+            {"search-trainers", BatchOp::SearchTrainers},
+            {"joined-between", BatchOp::JoinedBetween},
+            {"stats", BatchOp::Stats},
+            {"save", BatchOp::Save},
+        }};
+        for (const auto &entry : OPS)
+        {
+            if (entry.first == name)
+                return entry.second;
+        }
+        return BatchOp::Invalid;
+    }
+
+    // Stream 'input' into the queue, one batch at a time
+    static void readCommands(istream &input, BatchQueue &queue)
+    {
+        vector<BatchCommand> batch;
+        batch.reserve(COMMANDS_PER_BATCH);
+        string line;
+        size_t lineNumber = 0;
+        BatchCommand command;
+
+        while (getline(input, line))
+        {
+            lineNumber++;
+            if (!parseLine(line, lineNumber, command))
+                continue;
+            batch.push_back(std::move(command));
+            if (batch.size() == COMMANDS_PER_BATCH)
+            {
+                queue.push(std::move(batch));
+                batch = vector<BatchCommand>();
+                batch.reserve(COMMANDS_PER_BATCH);
+            }
+        }
+        if (!batch.empty())
+            queue.push(std::move(batch));
+        queue.close();
+    }
+
+    // ---------- Execution (calling thread) ----------
+
+    static void appendMember(string &out, const Member &member)
+    {
+        out += ' ';
+        out += to_string(member.getId());
+        out += " \"";
+        out += member.getName();
+        out += "\" ";
+        out += member.getEmail();
+        out += ' ';
+        out += subscriptionTypeName(member.getSubscriptionType());
+        out += ' ';
+        out += member.getJoinDate().toString();
+    }
+
+    static void appendTrainer(string &out, const Trainer &trainer)
+    {
+        out += ' ';
+        out += to_string(trainer.getId());
+        out += " \"";
+        out += trainer.getName();
+        out += "\" ";
+        out += trainer.getEmail();
+        out += ' ';
+        out += specialtyName(trainer.getTrainerSpecialty());
+        out += ' ';
+        out += to_string(trainer.getAssignedCount());
+    }
+
+    static void appendHits(string &out, const vector<SearchHit> &hits)
+    {
+        for (const SearchHit &hit : hits)
+        {
+            out += ' ';
+            out += to_string(hit.id);
+        }
+    }
+
+    // Run one command, appending "OK ..." or the failure reason to 'out'
+    EngineStatus execute(const BatchCommand &command, string &out)
+    {
+        EngineStatus status = EngineStatus::Ok;
+        switch (command.op)
+        {
+        case BatchOp::AddMember:
+        {
+            EngineResult<int> result = engine.addMember(command.text[0], command.text[1], command.text[2],
+                                                        command.tier, command.from);
+            status = result.status;
+            if (result.ok())
+                out += " OK " + to_string(result.value);
+            break;
+        }
+        case BatchOp::AddTrainer:
+        {
+            EngineResult<int> result = engine.addTrainer(command.text[0], command.text[1], command.text[2],
+                                                         command.specialty);
+            status = result.status;
+            if (result.ok())
+                out += " OK " + to_string(result.value);
+            break;
+        }
+        case BatchOp::UpdateMember:
+            status = engine.changeSubscription(command.id, command.tier);
+            break;
+        case BatchOp::UpdateTrainer:
+            status = engine.changeSpecialty(command.id, command.specialty);
+            break;
+        case BatchOp::DeleteMember:
+            status = engine.deleteMember(command.id);
+            break;
+        case BatchOp::DeleteTrainer:
+            status = engine.deleteTrainer(command.id);
+            break;
+        case BatchOp::Assign:
+            status = engine.assignMember(command.id, command.otherId);
+            break;
+        case BatchOp::FindMember:
+        {
+            GymEngine::ReadGuard guard = engine.readLock();
+            const Member *member = command.id >= 0 ? engine.findMember(command.id)
+                                                   : engine.findMemberByEmail(command.text[0]);
+            if (member == nullptr)
+                return EngineStatus::MemberNotFound;
+            out += " OK";
+            appendMember(out, *member);
+            return status;
+        }
+        case BatchOp::FindTrainer:
+        {
+            GymEngine::ReadGuard guard = engine.readLock();
+            const Trainer *trainer = command.id >= 0 ? engine.findTrainer(command.id)
+                                                     : engine.findTrainerByEmail(command.text[0]);
+            if (trainer == nullptr)
+                return EngineStatus::TrainerNotFound;
+            out += " OK";
+            appendTrainer(out, *trainer);
+            return status;
+        }
+        case BatchOp::SearchMembers:
+            out += " OK";
+            appendHits(out, engine.searchMembers(command.text[0]));
+            return status;
+        case BatchOp::SearchTrainers:
+            out += " OK";
+            appendHits(out, engine.searchTrainers(command.text[0]));
+            return status;
+        case BatchOp::JoinedBetween:
+        {
+            GymEngine::ReadGuard guard = engine.readLock();
+            out += " OK " + to_string(engine.findMembersJoinedBetween(command.from, command.to).size());
+            return status;
+        }
+        case BatchOp::Stats:
+        {
+            GymEngine::ReadGuard guard = engine.readLock();
+            const MemberAggregates &members = engine.getMemberStats();
+            const TrainerLoadHistogram &load = engine.getTrainerLoad();
+            out += " OK members=" + to_string(members.totalMembers()) +
+                   " standard=" + to_string(members.membersWith(SubscriptionType::Standard)) +
+                   " premium=" + to_string(members.membersWith(SubscriptionType::Premium)) +
+                   " trainers=" + to_string(load.totalTrainers()) +
+                   " assignments=" + to_string(load.totalAssignments());
+            return status;
+        }
+        case BatchOp::Save:
+        case BatchOp::Invalid:
+            break; // Handled by runCommand()
+        }
+
+        if (status == EngineStatus::Ok && command.op != BatchOp::AddMember && command.op != BatchOp::AddTrainer)
+            out += " OK";
+        return status;
+    }
+
+public:
+    static const size_t MAX_FIELDS = 6;
+
+    BatchService(GymEngine &gymEngine, PersistenceService *persistenceService = nullptr)
+        : engine(gymEngine), persistence(persistenceService) {}
+
+    // ---------- Parsing (also used by the server front-end) ----------
+
+    // Split a line into fields; returns the field count (MAX_FIELDS + 1 if too many)
+    static size_t splitFields(string_view line, array<string_view, MAX_FIELDS> &fields)
+    {
+        size_t count = 0;
+        size_t i = 0;
+        while (true)
+        {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r'))
+                i++;
+            if (i == line.size() || line[i] == '#')
+                return count;
+            if (count == MAX_FIELDS)
+                return MAX_FIELDS + 1;
+
+            size_t start = i;
+            if (line[i] == '"')
+            {
+                size_t close = line.find('"', i + 1);
+                if (close == string_view::npos)
+                    close = line.size();
+                fields[count++] = line.substr(start + 1, close - start - 1);
+                i = close == line.size() ? close : close + 1;
+            }
+            else
+            {
+                while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r')
+                    i++;
+                fields[count++] = line.substr(start, i - start);
+            }
+        }
+    }
+
+    // Parse one line into 'command'; false for blank / comment lines
+    static bool parseLine(string_view line, size_t lineNumber, BatchCommand &command)
+    {
+        array<string_view, MAX_FIELDS> fields;
+        size_t count = splitFields(line, fields);
+        if (count == 0)
+            return false;
+
+        command = BatchCommand();
+        command.line = lineNumber;
+        auto fail = [&command](const char *message) {
+            command.op = BatchOp::Invalid;
+            command.error = message;
+            return true;
+        };
+
+        BatchOp op = parseOp(fields[0]);
+        if (op == BatchOp::Invalid)
+            return fail("Unknown command");
+        command.op = op;
+        size_t args = count - 1;
+
+        switch (op)
+        {
+        case BatchOp::AddMember:
+            if (args != 4 && args != 5)
+                return fail("Usage: add-member <name> <email> <password> <tier> [YYYY-MM-DD]");
+            command.from = Date::today();
+            if (args == 5 && !Date::parse(fields[5], command.from))
+                return fail("Invalid join date (use YYYY-MM-DD)");
+            command.tier = parseSubscriptionType(fields[4]);
+            break;
+        case BatchOp::AddTrainer:
+            if (args != 4)
+                return fail("Usage: add-trainer <name> <email> <password> <specialty>");
+            command.specialty = parseSpecialty(fields[4]);
+            break;
+        case BatchOp::UpdateMember:
+        case BatchOp::UpdateTrainer:
+            if (args != 2)
+                return fail("Usage: update-member|update-trainer <id> <tier|specialty>");
+            if (!parseId(fields[1], command.id))
+                return fail("Invalid ID");
+            command.tier = parseSubscriptionType(fields[2]);
+            command.specialty = parseSpecialty(fields[2]);
+            return true;
+        case BatchOp::DeleteMember:
+        case BatchOp::DeleteTrainer:
+            if (args != 1)
+                return fail("Usage: delete-member|delete-trainer <id>");
+            if (!parseId(fields[1], command.id))
+                return fail("Invalid ID");
+            return true;
+        case BatchOp::Assign:
+            if (args != 2)
+                return fail("Usage: assign <trainer id> <member id>");
+            if (!parseId(fields[1], command.id) || !parseId(fields[2], command.otherId))
+                return fail("Invalid ID");
+            return true;
+        case BatchOp::FindMember:
+        case BatchOp::FindTrainer:
+            if (args != 1)
+                return fail("Usage: find-member|find-trainer <id | email>");
+            if (!parseId(fields[1], command.id))
+            {
+                command.id = -1;
+                command.text[0] = string(fields[1]);
+            }
+            return true;
+        case BatchOp::SearchMembers:
+        case BatchOp::SearchTrainers:
+            if (args != 1)
+                return fail("Usage: search-members|search-trainers <query>");
+            command.text[0] = string(fields[1]);
+            return true;
+        case BatchOp::JoinedBetween:
+            if (args != 2)
+                return fail("Usage: joined-between <YYYY-MM-DD> <YYYY-MM-DD>");
+            if (!Date::parse(fields[1], command.from) || !Date::parse(fields[2], command.to))
+                return fail("Invalid date (use YYYY-MM-DD)");
+            return true;
+        case BatchOp::Stats:
+        case BatchOp::Save:
+            if (args != 0)
+                return fail("This command takes no arguments");
+            return true;
+        case BatchOp::Invalid:
+            break;
+        }
+
+        // add-member / add-trainer: name, email, password
+        for (size_t i = 0; i < 3; i++)
+            command.text[i] = string(fields[i + 1]);
+        return true;
+    }
+
+    // ---------- Execution ----------
+
+    // Run one parsed command, appending " OK [result]" or " ERR <message>" to 'out'
+    // (returns false for ERR)
+    bool runCommand(const BatchCommand &command, string &out)
+    {
+        if (command.op == BatchOp::Invalid)
+        {
+            out += " ERR ";
+            out += command.error;
+            return false;
+        }
+
+        if (command.op == BatchOp::Save)
+        {
+            string error = "Nothing to save to";
+            if (persistence != nullptr && persistence->save(error))
+            {
+                out += " OK";
+                return true;
+            }
+            out += " ERR ";
+            out += error;
+            return false;
+        }
+
+        EngineStatus status = execute(command, out);
+        if (status == EngineStatus::Ok)
+            return true;
+        out += " ERR ";
+        out += engineStatusMessage(status);
+        return false;
+    }
+
+    // Write the buffered result lines, after committing the log records behind
+    // them. If the commit fails, one more line for 'lastLine' (the last command
+    // run) says so; the records stay queued and the next commit retries them.
+    void writeResults(string &out, ostream &output, size_t lastLine, BatchSummary &summary)
+    {
+        if (persistence != nullptr && !persistence->commitLog())
+        {
+            out += to_string(lastLine) + " ERR Cannot write " + persistence->getLogPath() +
+                   "; the changes up to this line are not yet durable\n";
+            summary.failed++;
+        }
+        output.write(out.data(), out.size());
+        out.clear();
+    }
+
+    // Run every command of 'input', writing one result line per command to 'output'
+    BatchSummary run(istream &input, ostream &output)
+    {
+        BatchSummary summary;
+        auto started = chrono::steady_clock::now();
+
+        if (persistence != nullptr)
+            persistence->setGroupCommit(GROUP_COMMIT_RECORDS, GROUP_COMMIT_DELAY_MS);
+
+        BatchQueue queue(QUEUED_BATCHES);
+        thread reader([&input, &queue] { readCommands(input, queue); });
+
+        string out;
+        out.reserve(OUTPUT_FLUSH_BYTES + 256);
+        vector<BatchCommand> batch;
+        size_t lastLine = 0;
+
+        while (queue.pop(batch))
+        {
+            for (const BatchCommand &command : batch)
+            {
+                summary.commands++;
+                out += to_string(command.line);
+                if (!runCommand(command, out))
+                    summary.failed++;
+                out += '\n';
+
+                lastLine = command.line;
+                if (out.size() >= OUTPUT_FLUSH_BYTES)
+                    writeResults(out, output, lastLine, summary);
+            }
+        }
+        reader.join();
+
+        writeResults(out, output, lastLine, summary);
+        output.flush();
+
+        if (persistence != nullptr)
+            persistence->setGroupCommit(1, 0);
+
+        summary.seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+        return summary;
+    }
+};
+
+#endif
@@ -6,16 +6,21 @@ using namespace std;
 // To prevent Windows Header conflicts
 #define WIN32_LEAN_AND_MEAN
 
+#include <algorithm>
 #include <iostream>
+#include <initializer_list>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iomanip>
 #include <sstream>
 
+#include "KeyInput.h"
+#include "ScreenBuffer.h"
+
 // Windows
 #ifdef _WIN32
 #include <windows.h>
-#include <conio.h>
 // Not Windows
 #else
 #include <sys/ioctl.h>
@@ -27,44 +32,47 @@ class ConsoleUI
 private:
     static const int DEFAULT_WIDTH = 80;
 
-    // --- NAVIGATION KEYS ---
-    static const int KEY_UP = 72;
-    static const int KEY_DOWN = 80;
-    static const int KEY_LEFT = 75;
-    static const int KEY_RIGHT = 77;
-    static const int KEY_HOME = 71;
-    static const int KEY_END = 79;
-
-    // --- ACTION KEYS ---
-    static const int ENTER_KEY = 13;
-    static const int BACKSPACE_KEY = 8;
-    static const int ESC_KEY = 27;
+    static const int RULE_WIDTH = 40;      // Menu separators
+    static const int FORM_RULE_WIDTH = 70; // Form separators
 
     // Clears any leftover keystrokes (prevents double-clicking menus)
     static void flushInput()
     {
-        while (_kbhit())
-        {
-            _getch();
-        }
+        KeyInput::drain();
+    }
+
+    // One keystroke (whatever was printed is shown first)
+    static KeyEvent readKey()
+    {
+        cout.flush();
+        return KeyInput::read();
     }
 
 public:
-    // Clear screen
+    // Menus and forms are drawn through one shared screen buffer
+    static ScreenBuffer &screen()
+    {
+        static ScreenBuffer buffer;
+        return buffer;
+    }
+
+    // Clear screen (escape sequences, no shell)
     static void clear()
     {
-#ifdef _WIN32
-        system("cls");
-#else
-        system("clear");
-#endif
+        screen().clearScreen();
     }
 
     // Wait for user to press any key
     static void pause()
     {
         cout << "\nPress any key to continue...";
-        _getch();
+        readKey();
+    }
+
+    // The keyboard is gone (stdin closed): menus return -1 at once
+    static bool inputClosed()
+    {
+        return KeyInput::closed();
     }
 
     // Cursor Mover
@@ -75,7 +83,7 @@ public:
 
     // --- SIMPLE INPUT HELPERS ---
     // Get user input with prompt
-    static string getInput(string prompt)
+    static string getInput(string_view prompt)
     {
         string input;
         cout << "\n"
@@ -85,7 +93,7 @@ public:
     }
 
     // Get integer input with validation
-    static int getIntInput(string prompt)
+    static int getIntInput(string_view prompt)
     {
         int input;
         while (true)
@@ -118,32 +126,32 @@ public:
 
     // --- OUTPUT HELPERS ---
     // Print header with title
-    static void printHeader(string title)
+    static void printHeader(string_view title)
     {
         clear();
         cout << "=== " << title << " ===" << endl;
     }
 
     // Print success message
-    static void printSuccess(string msg)
+    static void printSuccess(string_view msg)
     {
         cout << "\n\033[32m[SUCCESS] " << msg << "\033[0m" << endl;
     }
 
     // Print error message
-    static void printError(string msg)
+    static void printError(string_view msg)
     {
         cout << "\n\033[31m[ERROR] " << msg << "\033[0m" << endl;
     }
 
     // Print warning message
-    static void printWarning(string msg)
+    static void printWarning(string_view msg)
     {
         cout << "\n\033[31m[WARNING] " << msg << "\033[0m" << endl;
     }
 
     // Print info message
-    static void printInfo(string msg)
+    static void printInfo(string_view msg)
     {
         cout << "\n[INFO] " << msg << endl;
     }
@@ -153,13 +161,16 @@ public:
     // Draw Menu Title
     static void drawMenuTitle(const string &title)
     {
-        cout << "\n=== " << title << " ===\n";
-        cout << "----------------------------------------\n";
+        ScreenBuffer &out = screen();
+        out.print("\n=== " + title + " ===\n");
+        out.repeat('-', RULE_WIDTH);
+        out.print("\n");
     }
 
     // Draw Menu Options
     static void drawMenuOptions(const vector<string> &options, int currentSelection)
     {
+        ScreenBuffer &out = screen();
         // Color every Option in the Menu
         for (int i = 0; i < options.size(); i++)
         {
@@ -167,23 +178,36 @@ public:
             if (i == currentSelection)
             {
                 // Highlight (CYAN)
-                cout << "\033[96m -> " << options[i] << " \033[0m\n";
+                out.print(" -> " + options[i] + " ", ScreenBuffer::Color::Cyan);
+                out.print("\n");
             }
             // Not Selected Option
             else
             {
-                cout << "    " << options[i] << "\n";
+                out.print("    " + options[i] + "\n");
             }
         }
-        cout << "----------------------------------------\n";
+        out.repeat('-', RULE_WIDTH);
+        out.print("\n");
     }
 
-    // Draw the Menu Body
-    static void drawMenu(const string &title, const vector<string> &options, int currentSelection)
+    // Draw the Menu Body (summary: optional lines shown above the options)
+    // Only the cells that changed since the last draw reach the terminal.
+    static void drawMenu(const string &title, const vector<string> &options, int currentSelection,
+                         const string &summary = "")
     {
-        clear();
+        ScreenBuffer &out = screen();
+        out.begin();
         drawMenuTitle(title);
+        if (!summary.empty())
+        {
+            out.print(summary);
+            out.repeat('-', RULE_WIDTH);
+            out.print("\n");
+        }
         drawMenuOptions(options, currentSelection);
+        out.placeCursor(out.currentRow(), 0); // Below the menu, where later output goes
+        out.present();
     }
 
     // Handle Arrow UP
@@ -203,86 +227,102 @@ public:
     }
 
     // Handle Arrow Keys
-    static void handleArrowKey(int &currentSelection, const vector<string> &options)
+    static void handleArrowKey(KeyEvent key, int &currentSelection, const vector<string> &options)
     {
-        char key = _getch();
-
         // Detect the UP arrow
-        if (key == KEY_UP)
+        if (key.is(Key::Up))
             moveUp(currentSelection, options);
         // Detect the DOWN arrow
-        else if (key == KEY_DOWN)
+        else if (key.is(Key::Down))
             moveDown(currentSelection, options);
     }
 
     static bool handleMenuNavigation(int &currentSelection, const vector<string> &options)
     {
-        char key = _getch();
-
-        if (key == -32 || key == 224) // Arrow keys
-        {
-            handleArrowKey(currentSelection, options);
-            return false;
-        }
-        // Detect ENTER Key
-        else if (key == ENTER_KEY)
-        {
-            return true; // User confirmed selection
-        }
-
-        return false;
+        KeyEvent key = readKey();
+        handleArrowKey(key, currentSelection, options);
+        return key.is(Key::Enter); // User confirmed selection
     }
 
     // ------------ DRAWING THE MENU ------------
     // Returns index (0, 1, 2...)
-    static int getMenuSelection(string title, vector<string> options)
+    static int getMenuSelection(const string &title, const vector<string> &options, const string &summary = "")
     {
+        KeyInput::RawMode raw; // Keys arrive one by one, unechoed, for the whole menu
         flushInput(); // Clears the previous Enter key
+        screen().invalidate(); // Whatever was printed before is repainted once
         int currentSelection = 0;
-        char key;
 
         while (true)
         {
-            drawMenu(title, options, currentSelection);
+            drawMenu(title, options, currentSelection, summary);
 
             // --- MANUAL KEY HANDLING ---
-            key = _getch();
+            KeyEvent key = readKey();
 
-            if (key == -32 || key == 224)
-            {
-                key = _getch();
-                if (key == KEY_UP)
-                    moveUp(currentSelection, options);
-                else if (key == KEY_DOWN)
-                    moveDown(currentSelection, options);
-            }
-            else if (key == ENTER_KEY)
+            if (key.is(Key::Enter))
             {
                 return currentSelection;
             }
-            else if (key == ESC_KEY)
+            else if (key.is(Key::Escape) || key.is(Key::Closed))
             {
                 return -1; // SIGNAL FOR "BACK"
             }
+            handleArrowKey(key, currentSelection, options);
         }
     }
 
-    // Print table header
-    static void printTableHeader(const vector<string> &headers, const vector<int> &widths)
+    // ------------ PAGINATION ------------
+    // Show the page footer and wait for a page key: LEFT / RIGHT (or P / N),
+    // HOME / END for the first / last page, or a page number and Enter.
+    // Returns the page to show next, or -1 when ESC / Enter is pressed.
+    // A letter in 'commandKeys' (lower case) goes to 'command' instead, and
+    // the current page is returned.
+    static int getPageNavigation(int page, int pageCount, string_view commandKeys = "", char *command = nullptr)
     {
-        cout << endl;
-        for (size_t i = 0; i < headers.size(); i++)
-            cout << left << setw(widths[i]) << headers[i] << " ";
-        cout << endl
-             << string(60, '-') << endl;
-    }
+        cout << "\nPage " << page + 1 << " of " << pageCount
+             << "  [<-/->] Page  [Home/End]  [Number+Enter] Go to  [ESC] Back";
 
-    // Print table row
-    static void printTableRow(const vector<string> &columns, const vector<int> &widths)
-    {
-        for (size_t i = 0; i < columns.size(); i++)
-            cout << left << setw(widths[i]) << columns[i] << " ";
-        cout << endl;
+        KeyInput::RawMode raw;
+        string typed; // Page number typed so far
+        bool prompted = false;
+        while (true)
+        {
+            KeyEvent key = readKey();
+            char c = key.is(Key::Char) ? key.ch : 0;
+            char lower = (char)tolower((unsigned char)c);
+
+            if (command != nullptr && c != 0 && commandKeys.find(lower) != string_view::npos)
+            {
+                *command = lower;
+                return page;
+            }
+            else if (c >= '0' && c <= '9' && typed.size() < 9)
+            {
+                if (!prompted)
+                    cout << "  Go to: ";
+                prompted = true;
+                typed += c;
+                cout << c; // Raw mode does not echo
+            }
+            else if (key.is(Key::Backspace) && !typed.empty())
+            {
+                typed.pop_back();
+                cout << "\b \b";
+            }
+            else if (key.is(Key::Enter) && !typed.empty())
+                return max(1, min(stoi(typed), pageCount)) - 1;
+            else if ((key.is(Key::Left) || c == 'p' || c == 'P') && page > 0)
+                return page - 1;
+            else if ((key.is(Key::Right) || c == 'n' || c == 'N') && page + 1 < pageCount)
+                return page + 1;
+            else if (key.is(Key::Home) && page > 0)
+                return 0;
+            else if (key.is(Key::End) && page + 1 < pageCount)
+                return pageCount - 1;
+            else if (key.is(Key::Escape) || key.is(Key::Enter) || key.is(Key::Closed))
+                return -1;
+        }
     }
 
     // Print choice prompt
@@ -301,11 +341,12 @@ public:
     }
 
     // ------------ DRAWING UI OF THE FORM HELPERS ------------
+    // Rows / columns are 1-based terminal positions, as for moveCursor.
     static void drawFormTitle(const string &title)
     {
-        clear();
-        cout << "=== " << title << " ===\n";
-        cout << string(70, '-') << "\n";
+        ScreenBuffer &out = screen();
+        out.print("=== " + title + " ===\n");
+        out.repeat('-', FORM_RULE_WIDTH);
     }
 
     static void drawFieldLabels(
@@ -322,8 +363,8 @@ public:
             int currentRow = startRow + (i / 2);
             int labelCol = (i % 2 == 0) ? COL1_X : COL2_X;
 
-            moveCursor(currentRow, labelCol);
-            cout << fieldLabels[i] << ": ";
+            screen().moveTo(currentRow - 1, labelCol - 1);
+            screen().print(fieldLabels[i] + ": ");
 
             int inputStartCol = labelCol + fieldLabels[i].length() + 2;
 
@@ -336,10 +377,47 @@ public:
     {
         int footerRow = 3 + (fieldCount / 2) + 2;
 
-        moveCursor(footerRow, 1);
-        cout << string(70, '-') << "\n";
-        cout << "[ENTER] Next/Submit   [ESC] Cancel   [ARROWS] Navigate";
+        ScreenBuffer &out = screen();
+        out.moveTo(footerRow - 1, 0);
+        out.repeat('-', FORM_RULE_WIDTH);
+        out.print("\n[ENTER] Next/Submit   [ESC] Cancel   [ARROWS] Navigate");
+
+        return footerRow;
+    }
+
+    // Draw the typed values (passwords masked)
+    static void drawFieldValues(const vector<string> &fieldLabels, const vector<string> &inputs,
+                                const vector<int> &fieldRows, const vector<int> &fieldCols)
+    {
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            screen().moveTo(fieldRows[i] - 1, fieldCols[i] - 1);
+            if (fieldLabels[i] == "Password")
+                screen().repeat('*', (int)inputs[i].size());
+            else
+                screen().print(inputs[i]);
+        }
+    }
 
+    // One frame of the form, sent as the difference from the previous one
+    // The cursor goes after the current field's text (below the form for -1).
+    static int drawForm(const string &title, const vector<string> &fieldLabels, const vector<string> &inputs,
+                        vector<int> &fieldRows, vector<int> &fieldCols, int currentField)
+    {
+        screen().begin();
+        fieldRows.clear();
+        fieldCols.clear();
+        drawFormTitle(title);
+        drawFieldLabels(fieldLabels, fieldRows, fieldCols);
+        int footerRow = drawFooter(fieldLabels.size());
+        drawFieldValues(fieldLabels, inputs, fieldRows, fieldCols);
+
+        if (currentField < 0)
+            screen().placeCursor(footerRow + 1, 0);
+        else
+            screen().placeCursor(fieldRows[currentField] - 1,
+                                 fieldCols[currentField] - 1 + (int)inputs[currentField].length());
+        screen().present();
         return footerRow;
     }
 
@@ -373,13 +451,11 @@ public:
     static void handleBackspace(string &fieldValue)
     {
         if (!fieldValue.empty())
-        {
             fieldValue.pop_back();
-            cout << "\b \b";
-        }
     }
 
-    static void handleCharacter(int ch, string &fieldValue, int targetCol, int COL2_X, int currentField, bool isPassword = false)
+    // The screen shows the value on the next frame (masked for passwords)
+    static void handleCharacter(int ch, string &fieldValue, int targetCol, int COL2_X, int currentField)
     {
         if (ch >= 32 && ch <= 126) // Printable
         {
@@ -388,94 +464,76 @@ public:
             // 1. We are in Left Col AND have space (targetCol < 43)
             // 2. OR We are in Right Col (currentField is Odd)
             if ((targetCol < COL2_X - 2) || (currentField % 2 != 0))
-            {
                 fieldValue += (char)ch;
-                if (isPassword) {
-                    cout << '*'; 
-                } else {
-                    cout << (char)ch; 
-                }
-            }
         }
     }
 
     // ------------ DETECTING ARROWS ------------
-    static void handleArrowKeys(int ch, int &currentField, int fieldCount)
+    static void handleArrowKeys(KeyEvent key, int &currentField, int fieldCount)
     {
-        ch = _getch();
-
-        if (ch == KEY_UP)
+        if (key.is(Key::Up))
             moveUpField(currentField, fieldCount);
-        else if (ch == KEY_DOWN)
+        else if (key.is(Key::Down))
             moveDownField(currentField, fieldCount);
-        else if (ch == KEY_LEFT)
+        else if (key.is(Key::Left))
             moveLeftField(currentField);
-        else if (ch == KEY_RIGHT)
+        else if (key.is(Key::Right))
             moveRightField(currentField, fieldCount);
-        else if (ch == KEY_HOME)
+        else if (key.is(Key::Home))
             currentField = 0;
-        else if (ch == KEY_END)
+        else if (key.is(Key::End))
             currentField = fieldCount - 1;
     }
 
     // ------------ DRAWING THE FORM ------------
     static vector<string> getFormData(string title, vector<string> fieldLabels)
     {
+        KeyInput::RawMode raw; // Typed keys are drawn by the form, not echoed
         flushInput(); // Clears the previous Enter key
-        drawFormTitle(title);
+        screen().invalidate(); // The first frame repaints the whole screen
 
         vector<int> fieldRows;
         vector<int> fieldCols;
-
-        drawFieldLabels(fieldLabels, fieldRows, fieldCols);
-        int footerRow = drawFooter(fieldLabels.size());
-
         vector<string> inputs(fieldLabels.size(), "");
         int currentField = 0;
         bool finished = false;
 
         while (!finished)
         {
-            int targetRow = fieldRows[currentField];
+            drawForm(title, fieldLabels, inputs, fieldRows, fieldCols, currentField);
             int targetCol = fieldCols[currentField] + inputs[currentField].length();
 
-            moveCursor(targetRow, targetCol);
-
-            int ch = _getch();
+            KeyEvent key = readKey();
 
-            if (ch == 224 || ch == 0) // arrow keys
-            {
-                handleArrowKeys(ch, currentField, fieldLabels.size());
-            }
-            else if (ch == ESC_KEY)
+            if (key.is(Key::Escape) || key.is(Key::Closed))
             {
                 return {}; // cancel
             }
-            else if (ch == BACKSPACE_KEY)
+            else if (key.is(Key::Backspace))
             {
                 handleBackspace(inputs[currentField]);
             }
-            else if (ch == ENTER_KEY)
+            else if (key.is(Key::Enter))
             {
                 if (currentField < fieldLabels.size() - 1)
                     currentField++;
                 else
                     finished = true;
             }
-            else if (ch == ESC_KEY)
+            else if (key.is(Key::Char))
             {
-                return {}; // cancel
+                // FIX: Pass 'currentField' as the last argument
+                handleCharacter(key.ch, inputs[currentField], targetCol, 45, currentField);
             }
-            else
+            else // arrow keys
             {
-                string currentLabel = fieldLabels[currentField];
-                bool isPassword = currentLabel == "Password";
-                // FIX: Pass 'currentField' as the last argument
-                handleCharacter(ch, inputs[currentField], targetCol, 45, currentField, isPassword);
+                handleArrowKeys(key, currentField, fieldLabels.size());
             }
         }
 
-        moveCursor(footerRow + 2, 1);
+        // Leave the cursor under the form for the messages that follow
+        drawForm(title, fieldLabels, inputs, fieldRows, fieldCols, -1);
+        screen().invalidate();
         return inputs;
     }
 };
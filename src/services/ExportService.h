@@ -0,0 +1,416 @@
+#ifndef EXPORT_SERVICE_H
+#define EXPORT_SERVICE_H
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../core/GymEngine.h"
+#include "../storage/OutputBuffer.h"
+
+using namespace std;
+
+enum class ExportDataset : uint8_t
+{
+    Members,
+    Trainers,
+    Assignments // One row per trainer - member pair
+};
+
+enum class ExportFormat : uint8_t
+{
+    Csv,      // Header row + one line per row
+    JsonLines // One object per line
+};
+
+// Row filter: <column> <op> <value>, e.g. subscription=premium, join_date>=2024-01-01
+// Numeric columns compare as numbers, the others as case-insensitive text.
+struct ExportFilter
+{
+    enum class Op : uint8_t
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual
+    };
+
+    size_t column = 0;
+    Op op = Op::Equal;
+    string value;
+};
+
+// What to export and how
+struct ExportOptions
+{
+    ExportDataset dataset = ExportDataset::Members;
+    ExportFormat format = ExportFormat::Csv;
+    vector<size_t> columns;      // Column indexes in output order (empty = all)
+    vector<ExportFilter> where;  // All must match
+};
+
+// ExportService - streams members, trainers or assignments to CSV / JSON lines
+// Rows are read straight from the engine's storage and every value is
+// formatted into one reusable OutputBuffer, so memory use does not grow with
+// the number of rows and no per-field strings are built. The engine's read
+// lock is held for the whole export, so the rows form one consistent picture.
+class ExportService
+{
+private:
+    const GymEngine &engine;
+
+    // One rendered cell: text, or a number (then 'text' is its digits)
+    struct Value
+    {
+        string_view text;
+        int64_t number = 0;
+        bool numeric = false;
+    };
+
+    // Scratch space for numbers / dates of the row being written
+    struct Scratch
+    {
+        char bytes[32];
+    };
+
+    struct Assignment
+    {
+        const Trainer *trainer;
+        const Member *member;
+    };
+
+    static constexpr array<string_view, 6> MEMBER_COLUMNS = {"id", "name", "email", "subscription", "join_date",
+                                                             "trainers"};
+    static constexpr array<string_view, 5> TRAINER_COLUMNS = {"id", "name", "email", "specialty",
+                                                              "assigned_members"};
+    static constexpr array<string_view, 5> ASSIGNMENT_COLUMNS = {"trainer_id", "trainer_name", "member_id",
+                                                                 "member_name", "member_email"};
+
+    static Value number(int64_t value, Scratch &scratch)
+    {
+        char *end = to_chars(scratch.bytes, scratch.bytes + sizeof(scratch.bytes), value).ptr;
+        Value result;
+        result.text = string_view(scratch.bytes, end - scratch.bytes);
+        result.number = value;
+        result.numeric = true;
+        return result;
+    }
+
+    static Value text(string_view value)
+    {
+        Value result;
+        result.text = value;
+        return result;
+    }
+
+    // ---------- Cell values ----------
+
+    Value valueOf(const Member &member, size_t column, Scratch &scratch) const
+    {
+        switch (column)
+        {
+        case 0:
+            return number(member.getId(), scratch);
+        case 1:
+            return text(member.getName());
+        case 2:
+            return text(member.getEmail());
+        case 3:
+            return text(member.getSubscriptionName());
+        case 4:
+            member.getJoinDate().format(scratch.bytes);
+            return text(string_view(scratch.bytes, Date::TEXT_LENGTH));
+        default:
+            return number((int64_t)engine.getTrainerIdsOfMember(member.getId()).size(), scratch);
+        }
+    }
+
+    Value valueOf(const Trainer &trainer, size_t column, Scratch &scratch) const
+    {
+        switch (column)
+        {
+        case 0:
+            return number(trainer.getId(), scratch);
+        case 1:
+            return text(trainer.getName());
+        case 2:
+            return text(trainer.getEmail());
+        case 3:
+            return text(trainer.getTrainerSpecialtyName());
+        default:
+            return number((int64_t)trainer.getAssignedCount(), scratch);
+        }
+    }
+
+    Value valueOf(const Assignment &row, size_t column, Scratch &scratch) const
+    {
+        switch (column)
+        {
+        case 0:
+            return number(row.trainer->getId(), scratch);
+        case 1:
+            return text(row.trainer->getName());
+        case 2:
+            return number(row.member->getId(), scratch);
+        case 3:
+            return text(row.member->getName());
+        default:
+            return text(row.member->getEmail());
+        }
+    }
+
+    // ---------- Filtering ----------
+
+    static int compareText(string_view a, string_view b)
+    {
+        size_t length = min(a.size(), b.size());
+        for (size_t i = 0; i < length; i++)
+        {
+            int x = tolower((unsigned char)a[i]);
+            int y = tolower((unsigned char)b[i]);
+            if (x != y)
+                return x < y ? -1 : 1;
+        }
+        return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+    }
+
+    static bool matches(const Value &value, const ExportFilter &filter)
+    {
+        int order;
+        int64_t wanted = 0;
+        const char *end = filter.value.data() + filter.value.size();
+        if (value.numeric && from_chars(filter.value.data(), end, wanted).ptr == end && !filter.value.empty())
+            order = value.number < wanted ? -1 : (value.number > wanted ? 1 : 0);
+        else
+            order = compareText(value.text, filter.value);
+
+        switch (filter.op)
+        {
+        case ExportFilter::Op::Equal: return order == 0;
+        case ExportFilter::Op::NotEqual: return order != 0;
+        case ExportFilter::Op::Less: return order < 0;
+        case ExportFilter::Op::LessOrEqual: return order <= 0;
+        case ExportFilter::Op::Greater: return order > 0;
+        case ExportFilter::Op::GreaterOrEqual: return order >= 0;
+        }
+        return false;
+    }
+
+    // ---------- Writing ----------
+
+    template <size_t N>
+    static void writeHeader(OutputBuffer &out, const ExportOptions &options, const array<string_view, N> &names)
+    {
+        if (options.format != ExportFormat::Csv)
+            return;
+        for (size_t i = 0; i < options.columns.size(); i++)
+        {
+            if (i > 0)
+                out.put(',');
+            out.put(names[options.columns[i]]);
+        }
+        out.put('\n');
+    }
+
+    // Write one row if it passes every filter (returns whether it was written)
+    template <typename Row, size_t N>
+    bool writeRow(OutputBuffer &out, const ExportOptions &options, const array<string_view, N> &names,
+                  const Row &row) const
+    {
+        Scratch scratch;
+        for (const ExportFilter &filter : options.where)
+        {
+            if (!matches(valueOf(row, filter.column, scratch), filter))
+                return false;
+        }
+
+        if (options.format == ExportFormat::JsonLines)
+            out.put('{');
+        for (size_t i = 0; i < options.columns.size(); i++)
+        {
+            size_t column = options.columns[i];
+            Value value = valueOf(row, column, scratch);
+
+            if (options.format == ExportFormat::Csv)
+            {
+                if (i > 0)
+                    out.put(',');
+                if (value.numeric)
+                    out.put(value.text);
+                else
+                    out.putCsv(value.text);
+            }
+            else
+            {
+                if (i > 0)
+                    out.put(',');
+                out.putJson(names[column]);
+                out.put(':');
+                if (value.numeric)
+                    out.put(value.text);
+                else
+                    out.putJson(value.text);
+            }
+        }
+        out.put(options.format == ExportFormat::JsonLines ? "}\n" : "\n");
+        return true;
+    }
+
+    static vector<string_view> split(string_view text, char separator)
+    {
+        vector<string_view> parts;
+        size_t start = 0;
+        while (start <= text.size())
+        {
+            size_t stop = text.find(separator, start);
+            if (stop == string_view::npos)
+                stop = text.size();
+            parts.push_back(text.substr(start, stop - start));
+            start = stop + 1;
+        }
+        return parts;
+    }
+
+public:
+    ExportService(const GymEngine &gymEngine) : engine(gymEngine) {}
+
+    // Column names of a dataset, in default order
+    static vector<string_view> columnNames(ExportDataset dataset)
+    {
+        switch (dataset)
+        {
+        case ExportDataset::Members:
+            return vector<string_view>(MEMBER_COLUMNS.begin(), MEMBER_COLUMNS.end());
+        case ExportDataset::Trainers:
+            return vector<string_view>(TRAINER_COLUMNS.begin(), TRAINER_COLUMNS.end());
+        default:
+            return vector<string_view>(ASSIGNMENT_COLUMNS.begin(), ASSIGNMENT_COLUMNS.end());
+        }
+    }
+
+    // Index of a column name (-1 if the dataset has no such column)
+    static int columnIndex(ExportDataset dataset, string_view name)
+    {
+        vector<string_view> names = columnNames(dataset);
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            if (compareText(names[i], name) == 0)
+                return (int)i;
+        }
+        return -1;
+    }
+
+    // "id,name,email" -> column indexes (false + error on an unknown name)
+    static bool parseColumns(ExportDataset dataset, string_view list, vector<size_t> &columns, string &error)
+    {
+        columns.clear();
+        for (string_view name : split(list, ','))
+        {
+            int index = columnIndex(dataset, name);
+            if (index < 0)
+            {
+                error = "Unknown column '" + string(name) + "'";
+                return false;
+            }
+            columns.push_back((size_t)index);
+        }
+        return true;
+    }
+
+    // "join_date>=2024-01-01" -> filter (false + error if malformed)
+    static bool parseFilter(ExportDataset dataset, string_view text, ExportFilter &filter, string &error)
+    {
+        static const array<pair<string_view, ExportFilter::Op>, 6> OPS = {{
+            {"!=", ExportFilter::Op::NotEqual},
+            {"<=", ExportFilter::Op::LessOrEqual},
+            {">=", ExportFilter::Op::GreaterOrEqual},
+            {"=", ExportFilter::Op::Equal},
+            {"<", ExportFilter::Op::Less},
+            {">", ExportFilter::Op::Greater},
+        }};
+
+        size_t at = text.find_first_of("!<>=");
+        if (at == string_view::npos || at == 0)
+        {
+            error = "Filter must look like <column><op><value> (ops: = != < <= > >=)";
+            return false;
+        }
+
+        string_view rest = text.substr(at);
+        for (const auto &op : OPS)
+        {
+            if (rest.substr(0, op.first.size()) != op.first)
+                continue;
+
+            int index = columnIndex(dataset, text.substr(0, at));
+            if (index < 0)
+            {
+                error = "Unknown column '" + string(text.substr(0, at)) + "'";
+                return false;
+            }
+            filter.column = (size_t)index;
+            filter.op = op.second;
+            filter.value = string(rest.substr(op.first.size()));
+            return true;
+        }
+
+        error = "Unknown operator in '" + string(text) + "'";
+        return false;
+    }
+
+    // Stream the selected rows to 'file'; returns how many were written
+    // ('ok' turns false if the file could not be written)
+    size_t exportTo(FILE *file, ExportOptions options, bool &ok) const
+    {
+        if (options.columns.empty())
+        {
+            size_t count = columnNames(options.dataset).size();
+            for (size_t i = 0; i < count; i++)
+                options.columns.push_back(i);
+        }
+
+        OutputBuffer out(file);
+        size_t rows = 0;
+        GymEngine::ReadGuard guard = engine.readLock();
+
+        switch (options.dataset)
+        {
+        case ExportDataset::Members:
+            writeHeader(out, options, MEMBER_COLUMNS);
+            for (const Member &member : engine.getMembers())
+                rows += writeRow(out, options, MEMBER_COLUMNS, member);
+            break;
+
+        case ExportDataset::Trainers:
+            writeHeader(out, options, TRAINER_COLUMNS);
+            for (const Trainer &trainer : engine.getTrainers())
+                rows += writeRow(out, options, TRAINER_COLUMNS, trainer);
+            break;
+
+        case ExportDataset::Assignments:
+            writeHeader(out, options, ASSIGNMENT_COLUMNS);
+            for (const Trainer &trainer : engine.getTrainers())
+            {
+                for (Handle<Member> handle : trainer.getAssignedMembers())
+                {
+                    const Member *member = engine.getMembers().get(handle);
+                    if (member != nullptr)
+                        rows += writeRow(out, options, ASSIGNMENT_COLUMNS, Assignment{&trainer, member});
+                }
+            }
+            break;
+        }
+
+        ok = out.flush() && fflush(file) == 0;
+        return rows;
+    }
+};
+
+#endif
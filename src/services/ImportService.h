@@ -0,0 +1,652 @@
+#ifndef IMPORT_SERVICE_H
+#define IMPORT_SERVICE_H
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../core/GymEngine.h"
+#include "../services/PersistenceService.h"
+#include "../storage/MappedFile.h"
+
+using namespace std;
+
+enum class ImportKind : uint8_t
+{
+    Members,
+    Trainers
+};
+
+// A row that was not imported
+struct ImportError
+{
+    size_t line;
+    string message;
+};
+
+// Totals of one import
+struct ImportSummary
+{
+    size_t rows = 0;     // Data rows read (header / blank lines not counted)
+    size_t imported = 0; // Rows added to the engine
+    vector<ImportError> errors;
+    double seconds = 0;
+
+    size_t rejected() const { return errors.size(); }
+    double rowsPerSecond() const { return seconds > 0 ? rows / seconds : 0; }
+};
+
+// ImportService - bulk loads members / trainers from CSV or JSON lines
+// CSV: a header row names the columns (any order, case-insensitive):
+//   name, email, password, subscription (tier), join_date, specialty
+// JSON lines: one flat object per line with the same keys.
+// Members need name, email and subscription (join_date defaults to today);
+// trainers need name, email and specialty. Password is optional.
+//
+// The file is memory-mapped and cut into chunks at line boundaries. Worker
+// threads parse and validate chunks (normalising tiers / specialties and
+// checking email format) while the calling thread commits finished chunks in
+// file order: one engine batch per chunk (one block of IDs, uniqueness checked
+// against the engine) followed by one log commit.
+class ImportService
+{
+private:
+    GymEngine &engine;
+    PersistenceService *persistence; // nullptr = nothing to commit
+
+    static const size_t CHUNK_BYTES = 256 * 1024; // About 4k rows per batch
+    static const size_t CHUNKS_AHEAD_PER_THREAD = 2; // Bounds parsed-but-uncommitted rows
+
+    enum class Column : uint8_t
+    {
+        Name,
+        Email,
+        Password,
+        Subscription,
+        JoinDate,
+        Specialty,
+        Ignored
+    };
+
+    static const size_t COLUMN_COUNT = 6; // Without Ignored
+
+    // Parsed, validated rows of one chunk (line numbers relative to the chunk)
+    struct ParsedChunk
+    {
+        vector<MemberDraft> members;
+        vector<TrainerDraft> trainers;
+        vector<size_t> lines; // Line of each draft
+        vector<ImportError> errors;
+        size_t lineCount = 0;
+        size_t rows = 0;
+    };
+
+    // ---------- Field helpers ----------
+
+    static string_view trim(string_view text)
+    {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == string_view::npos)
+            return string_view();
+        size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    static Column columnOf(string_view header)
+    {
+        string key;
+        for (char c : trim(header))
+        {
+            if (c != '_' && c != ' ' && c != '-')
+                key += (char)tolower((unsigned char)c);
+        }
+        if (key == "name" || key == "fullname")
+            return Column::Name;
+        if (key == "email" || key == "mail")
+            return Column::Email;
+        if (key == "password")
+            return Column::Password;
+        if (key == "subscription" || key == "tier" || key == "type")
+            return Column::Subscription;
+        if (key == "joindate" || key == "joined")
+            return Column::JoinDate;
+        if (key == "specialty" || key == "speciality")
+            return Column::Specialty;
+        return Column::Ignored;
+    }
+
+    // Cheap shape check: one '@', something before it, a dot inside the domain
+    static bool isValidEmail(string_view email)
+    {
+        size_t at = email.find('@');
+        if (at == string_view::npos || at == 0 || email.find('@', at + 1) != string_view::npos)
+            return false;
+
+        string_view domain = email.substr(at + 1);
+        size_t dot = domain.find('.');
+        if (dot == string_view::npos || dot == 0 || domain.back() == '.')
+            return false;
+
+        for (char c : email)
+        {
+            if ((unsigned char)c <= ' ' || c == ',' || c == '"' || c == '<' || c == '>')
+                return false;
+        }
+        return true;
+    }
+
+    // Split one CSV line into fields ("" inside quotes is a literal quote)
+    // Quoted fields may not span lines. Returns false on an unterminated quote.
+    static bool splitCsv(string_view line, vector<string> &fields)
+    {
+        fields.clear();
+        size_t i = 0;
+        while (true)
+        {
+            string field;
+            while (i < line.size() && line[i] == ' ')
+                i++;
+
+            if (i < line.size() && line[i] == '"')
+            {
+                i++;
+                while (true)
+                {
+                    if (i >= line.size())
+                        return false;
+                    if (line[i] == '"')
+                    {
+                        if (i + 1 < line.size() && line[i + 1] == '"')
+                        {
+                            field += '"';
+                            i += 2;
+                            continue;
+                        }
+                        i++;
+                        break;
+                    }
+                    field += line[i++];
+                }
+                while (i < line.size() && line[i] != ',')
+                    i++;
+            }
+            else
+            {
+                size_t comma = line.find(',', i);
+                size_t stop = comma == string_view::npos ? line.size() : comma;
+                field = string(trim(line.substr(i, stop - i)));
+                i = stop;
+            }
+
+            fields.push_back(std::move(field));
+            if (i >= line.size())
+                return true;
+            i++; // Skip the comma
+        }
+    }
+
+    static void appendUtf8(string &out, uint32_t code)
+    {
+        if (code < 0x80)
+            out += (char)code;
+        else if (code < 0x800)
+        {
+            out += (char)(0xC0 | (code >> 6));
+            out += (char)(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            out += (char)(0xE0 | (code >> 12));
+            out += (char)(0x80 | ((code >> 6) & 0x3F));
+            out += (char)(0x80 | (code & 0x3F));
+        }
+    }
+
+    // JSON string starting after the opening quote; 'i' ends after the closing one
+    static bool readJsonString(string_view line, size_t &i, string &out)
+    {
+        out.clear();
+        while (i < line.size())
+        {
+            char c = line[i++];
+            if (c == '"')
+                return true;
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+            if (i >= line.size())
+                return false;
+
+            char escape = line[i++];
+            switch (escape)
+            {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u':
+            {
+                if (i + 4 > line.size())
+                    return false;
+                uint32_t code = 0;
+                for (size_t k = 0; k < 4; k++)
+                {
+                    char h = line[i++];
+                    code <<= 4;
+                    if (h >= '0' && h <= '9') code |= h - '0';
+                    else if (h >= 'a' && h <= 'f') code |= h - 'a' + 10;
+                    else if (h >= 'A' && h <= 'F') code |= h - 'A' + 10;
+                    else return false;
+                }
+                appendUtf8(out, code);
+                break;
+            }
+            default: out += escape; break; // \" \\ \/
+            }
+        }
+        return false;
+    }
+
+    // One flat JSON object into per-column values (unknown keys are skipped)
+    static bool parseJsonObject(string_view line, array<string, COLUMN_COUNT> &values)
+    {
+        for (string &value : values)
+            value.clear();
+
+        size_t i = 0;
+        auto skipSpaces = [&] {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r'))
+                i++;
+        };
+
+        skipSpaces();
+        if (i >= line.size() || line[i++] != '{')
+            return false;
+
+        string key, value;
+        while (true)
+        {
+            skipSpaces();
+            if (i < line.size() && line[i] == '}')
+                return true;
+            if (i >= line.size() || line[i++] != '"' || !readJsonString(line, i, key))
+                return false;
+
+            skipSpaces();
+            if (i >= line.size() || line[i++] != ':')
+                return false;
+            skipSpaces();
+
+            if (i < line.size() && line[i] == '"')
+            {
+                i++;
+                if (!readJsonString(line, i, value))
+                    return false;
+            }
+            else
+            {
+                size_t start = i;
+                while (i < line.size() && line[i] != ',' && line[i] != '}')
+                    i++;
+                value = string(trim(line.substr(start, i - start)));
+                if (value == "null")
+                    value.clear();
+            }
+
+            Column column = columnOf(key);
+            if (column != Column::Ignored)
+                values[(size_t)column] = std::move(value);
+
+            skipSpaces();
+            if (i < line.size() && line[i] == ',')
+            {
+                i++;
+                continue;
+            }
+            if (i < line.size() && line[i] == '}')
+                return true;
+            return false;
+        }
+    }
+
+    // ---------- Parsing (worker threads) ----------
+
+    // Validate one row's values and turn it into a draft
+    static const char *addRow(ImportKind kind, array<string, COLUMN_COUNT> &values, size_t line, ParsedChunk &chunk)
+    {
+        string &name = values[(size_t)Column::Name];
+        string &email = values[(size_t)Column::Email];
+        if (name.empty())
+            return "Missing name";
+        if (!isValidEmail(email))
+            return "Invalid email";
+
+        if (kind == ImportKind::Members)
+        {
+            MemberDraft draft;
+            draft.type = parseSubscriptionType(values[(size_t)Column::Subscription]);
+            if (draft.type == SubscriptionType::Unknown)
+                return "Invalid subscription type";
+
+            const string &joined = values[(size_t)Column::JoinDate];
+            if (joined.empty())
+                draft.joinDate = Date::today();
+            else if (!Date::parse(joined, draft.joinDate))
+                return "Invalid join date (use YYYY-MM-DD)";
+
+            draft.name = std::move(name);
+            draft.email = std::move(email);
+            draft.password = std::move(values[(size_t)Column::Password]);
+            chunk.members.push_back(std::move(draft));
+        }
+        else
+        {
+            TrainerDraft draft;
+            draft.specialty = parseSpecialty(values[(size_t)Column::Specialty]);
+            if (draft.specialty == Specialty::Unknown)
+                return "Invalid specialty";
+
+            draft.name = std::move(name);
+            draft.email = std::move(email);
+            draft.password = std::move(values[(size_t)Column::Password]);
+            chunk.trainers.push_back(std::move(draft));
+        }
+        chunk.lines.push_back(line);
+        return nullptr;
+    }
+
+    // Parse the lines of [begin, end); 'csvColumns' empty = JSON lines
+    static void parseChunk(ImportKind kind, const vector<Column> &csvColumns, const char *begin, const char *end,
+                           ParsedChunk &chunk)
+    {
+        vector<string> fields;
+        array<string, COLUMN_COUNT> values;
+        size_t line = 0;
+
+        const char *cursor = begin;
+        while (cursor < end)
+        {
+            const char *newline = (const char *)memchr(cursor, '\n', end - cursor);
+            const char *stop = newline != nullptr ? newline : end;
+            string_view text(cursor, stop - cursor);
+            cursor = stop + 1;
+            line++;
+
+            if (trim(text).empty())
+                continue;
+            chunk.rows++;
+
+            bool parsed;
+            if (csvColumns.empty())
+                parsed = parseJsonObject(text, values);
+            else
+            {
+                parsed = splitCsv(text, fields);
+                for (string &value : values)
+                    value.clear();
+                for (size_t i = 0; parsed && i < fields.size() && i < csvColumns.size(); i++)
+                {
+                    if (csvColumns[i] != Column::Ignored)
+                        values[(size_t)csvColumns[i]] = std::move(fields[i]);
+                }
+            }
+
+            const char *error = parsed ? addRow(kind, values, line, chunk)
+                                       : (csvColumns.empty() ? "Malformed JSON object" : "Unterminated quote");
+            if (error != nullptr)
+                chunk.errors.push_back({line, error});
+        }
+        chunk.lineCount = line;
+    }
+
+    // ---------- Committing (calling thread) ----------
+
+    // Add the rows of a chunk and commit their log records (false if the
+    // commit failed; the rows are then in memory but not saved)
+    bool commitChunk(ImportKind kind, ParsedChunk &chunk, size_t firstLine, ImportSummary &summary)
+    {
+        vector<EngineStatus> statuses;
+        if (kind == ImportKind::Members)
+            summary.imported += engine.addMembers(chunk.members, statuses);
+        else
+            summary.imported += engine.addTrainers(chunk.trainers, statuses);
+
+        bool saved = persistence == nullptr || persistence->commitLog();
+
+        // Parse errors and engine rejections, in line order
+        for (size_t i = 0; i < statuses.size(); i++)
+        {
+            if (statuses[i] != EngineStatus::Ok)
+                chunk.errors.push_back({chunk.lines[i], string(engineStatusMessage(statuses[i]))});
+        }
+        sort(chunk.errors.begin(), chunk.errors.end(),
+             [](const ImportError &a, const ImportError &b) { return a.line < b.line; });
+
+        summary.rows += chunk.rows;
+        for (ImportError &error : chunk.errors)
+        {
+            error.line += firstLine - 1;
+            summary.errors.push_back(std::move(error));
+        }
+        chunk = ParsedChunk(); // Free the rows now
+        return saved;
+    }
+
+    // Cut [begin, end) into chunks that end on a line break
+    static vector<pair<const char *, const char *>> splitChunks(const char *begin, const char *end)
+    {
+        vector<pair<const char *, const char *>> chunks;
+        while (begin < end)
+        {
+            const char *stop = begin + min((size_t)(end - begin), CHUNK_BYTES);
+            if (stop < end)
+            {
+                const char *newline = (const char *)memchr(stop, '\n', end - stop);
+                stop = newline != nullptr ? newline + 1 : end;
+            }
+            chunks.push_back({begin, stop});
+            begin = stop;
+        }
+        return chunks;
+    }
+
+public:
+    ImportService(GymEngine &gymEngine, PersistenceService *persistenceService = nullptr)
+        : engine(gymEngine), persistence(persistenceService) {}
+
+    // Import a CSV or JSON-lines file (false + error if it can't be read at all)
+    // Rows that fail are listed in summary.errors; the others are imported.
+    bool importFile(ImportKind kind, const string &path, ImportSummary &summary, string &error)
+    {
+        auto started = chrono::steady_clock::now();
+        summary = ImportSummary();
+
+        MappedFile file;
+        if (!file.open(path))
+        {
+            error = "Cannot open " + path;
+            return false;
+        }
+
+        const char *begin = file.data();
+        const char *end = begin + file.size();
+        if (file.size() >= 3 && memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+            begin += 3; // UTF-8 byte order mark
+
+        // JSON lines start with '{'; anything else is CSV with a header row
+        const char *first = begin;
+        while (first < end && (*first == ' ' || *first == '\t' || *first == '\r' || *first == '\n'))
+            first++;
+        bool json = first < end && *first == '{';
+
+        vector<Column> csvColumns;
+        size_t firstLine = 1;
+        if (!json)
+        {
+            const char *newline = (const char *)memchr(begin, '\n', end - begin);
+            const char *stop = newline != nullptr ? newline : end;
+            vector<string> headers;
+            if (begin == end || !splitCsv(string_view(begin, stop - begin), headers))
+            {
+                error = "Missing or malformed CSV header row";
+                return false;
+            }
+
+            bool present[COLUMN_COUNT] = {};
+            for (const string &header : headers)
+            {
+                Column column = columnOf(header);
+                csvColumns.push_back(column);
+                if (column != Column::Ignored)
+                    present[(size_t)column] = true;
+            }
+
+            Column required = kind == ImportKind::Members ? Column::Subscription : Column::Specialty;
+            if (!present[(size_t)Column::Name] || !present[(size_t)Column::Email] || !present[(size_t)required])
+            {
+                error = kind == ImportKind::Members ? "CSV header needs name, email and subscription columns"
+                                                    : "CSV header needs name, email and specialty columns";
+                return false;
+            }
+
+            begin = newline != nullptr ? newline + 1 : end;
+            firstLine = 2;
+        }
+
+        vector<pair<const char *, const char *>> ranges = splitChunks(begin, end);
+        vector<ParsedChunk> chunks(ranges.size());
+        vector<char> parsed(ranges.size(), 0);
+
+        size_t workers = max(1u, thread::hardware_concurrency());
+        workers = min(workers, max((size_t)1, ranges.size()));
+        size_t window = workers * CHUNKS_AHEAD_PER_THREAD;
+
+        mutex lock;
+        condition_variable chunkParsed, chunkCommitted;
+        size_t nextChunk = 0;
+        size_t committed = 0;
+
+        auto work = [&] {
+            while (true)
+            {
+                size_t index;
+                {
+                    unique_lock<mutex> guard(lock);
+                    chunkCommitted.wait(guard, [&] { return nextChunk >= ranges.size() || nextChunk < committed + window; });
+                    if (nextChunk >= ranges.size())
+                        return;
+                    index = nextChunk++;
+                }
+
+                parseChunk(kind, csvColumns, ranges[index].first, ranges[index].second, chunks[index]);
+
+                lock_guard<mutex> guard(lock);
+                parsed[index] = 1;
+                chunkParsed.notify_all();
+            }
+        };
+
+        if (persistence != nullptr)
+            persistence->setGroupCommit(SIZE_MAX, 0); // One commit per chunk (below)
+
+        vector<thread> threads;
+        for (size_t i = 0; i < workers; i++)
+            threads.emplace_back(work);
+
+        // Commit in file order while later chunks are still being parsed
+        size_t line = firstLine;
+        bool saved = true;
+        for (size_t i = 0; i < chunks.size() && saved; i++)
+        {
+            {
+                unique_lock<mutex> guard(lock);
+                chunkParsed.wait(guard, [&] { return parsed[i] != 0; });
+            }
+
+            size_t lineCount = chunks[i].lineCount;
+            saved = commitChunk(kind, chunks[i], line, summary);
+            if (!saved)
+                error = "Cannot write " + persistence->getLogPath() + "; import stopped, the rows from line " +
+                        to_string(line) + " on are not saved";
+            line += lineCount;
+
+            lock_guard<mutex> guard(lock);
+            committed = i + 1;
+            if (!saved)
+                nextChunk = ranges.size(); // Parse no more chunks
+            chunkCommitted.notify_all();
+        }
+
+        for (thread &worker : threads)
+            worker.join();
+
+        if (persistence != nullptr)
+            persistence->setGroupCommit(1, 0);
+
+        summary.seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+        return saved;
+    }
+
+    // Throughput benchmark: write 'rows' synthetic members to 'path', import
+    // them into a fresh engine (no logging) and print the timings to 'out'
+    static bool benchmark(size_t rows, const string &path, ostream &out)
+    {
+        FILE *file = fopen(path.c_str(), "wb");
+        if (file == nullptr)
+        {
+            out << "Cannot create " << path << endl;
+            return false;
+        }
+
+        string buffer = "name,email,password,subscription,join_date\n";
+        char row[160];
+        for (size_t i = 0; i < rows; i++)
+        {
+            int length = snprintf(row, sizeof(row), "Bench Member %zu,bench%zu@elforma.test,pw%zu,%s,2024-%02zu-%02zu\n",
+                                  i, i, i, i % 3 == 0 ? "Premium" : "Standard", i % 12 + 1, i % 28 + 1);
+            buffer.append(row, length);
+            if (buffer.size() >= (1 << 20))
+            {
+                fwrite(buffer.data(), 1, buffer.size(), file);
+                buffer.clear();
+            }
+        }
+        fwrite(buffer.data(), 1, buffer.size(), file);
+        fclose(file);
+
+        GymEngine engine;
+        ImportService importer(engine);
+        ImportSummary summary;
+        string error;
+        bool ok = importer.importFile(ImportKind::Members, path, summary, error);
+        remove(path.c_str());
+
+        if (!ok)
+        {
+            out << error << endl;
+            return false;
+        }
+
+        out << "# imported " << summary.imported << " of " << summary.rows << " rows ("
+            << summary.rejected() << " rejected) in " << summary.seconds << " s, "
+            << (size_t)summary.rowsPerSecond() << " rows/s on " << max(1u, thread::hardware_concurrency())
+            << " threads" << endl;
+        return summary.imported == rows;
+    }
+};
+
+#endif
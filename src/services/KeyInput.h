@@ -0,0 +1,288 @@
+#ifndef KEY_INPUT_H
+#define KEY_INPUT_H
+
+#include <cstdint>
+#include <initializer_list>
+
+#ifdef _WIN32
+#include <conio.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// A key as the UI sees it (the same on every platform)
+enum class Key : uint8_t
+{
+    Char, // A printable character (KeyEvent::ch)
+    Enter,
+    Escape,
+    Backspace,
+    Delete,
+    Up,
+    Down,
+    Left,
+    Right,
+    Home,
+    End,
+    Other, // Anything else (function keys, unknown sequences)
+    Closed // No more input (stdin closed)
+};
+
+struct KeyEvent
+{
+    Key key = Key::Other;
+    char ch = 0; // For Key::Char
+
+    bool is(Key other) const { return key == other; }
+};
+
+// KeyInput - single keystrokes without waiting for Enter
+// Windows reads the console with _getch and its 0 / 224 scan-code prefixes.
+// POSIX puts the terminal in raw mode (no line buffering, no echo; Ctrl+C
+// still works) and decodes the escape sequences terminals send for arrows,
+// Home / End and Delete. A lone ESC is told apart from the start of a
+// sequence by waiting at most ESCAPE_TIMEOUT_MS for the next byte.
+class KeyInput
+{
+private:
+    static KeyEvent fromByte(int c)
+    {
+        switch (c)
+        {
+        case '\r':
+        case '\n':
+            return {Key::Enter};
+        case 27:
+            return {Key::Escape};
+        case 8:
+        case 127:
+            return {Key::Backspace};
+        }
+        if (c >= 32 && c <= 126)
+            return {Key::Char, (char)c};
+        return {Key::Other};
+    }
+
+public:
+    static const int ESCAPE_TIMEOUT_MS = 25;
+
+#ifdef _WIN32
+    // Raw mode is the console's normal state for _getch
+    class RawMode
+    {
+    public:
+        RawMode() {}
+    };
+
+    static KeyEvent read()
+    {
+        int c = _getch();
+        if (c == 0 || c == 224) // Extended key: the scan code follows
+        {
+            switch (_getch())
+            {
+            case 72: return {Key::Up};
+            case 80: return {Key::Down};
+            case 75: return {Key::Left};
+            case 77: return {Key::Right};
+            case 71: return {Key::Home};
+            case 79: return {Key::End};
+            case 83: return {Key::Delete};
+            default: return {Key::Other};
+            }
+        }
+        return fromByte(c);
+    }
+
+    // Throw away keys typed ahead (never blocks)
+    static void drain()
+    {
+        while (_kbhit())
+            _getch();
+    }
+
+    static bool closed() { return false; }
+
+#else
+private:
+    struct State
+    {
+        termios saved;
+        bool saving = false; // 'saved' holds the terminal's own settings
+        int depth = 0;       // Nested RawMode guards
+        bool closed = false; // stdin reached end of file
+    };
+
+    static State &state()
+    {
+        static State instance;
+        return instance;
+    }
+
+    // Put the terminal back before dying from a signal (Ctrl+C, kill, hang-up)
+    static void restoreAndRaise(int signalNumber)
+    {
+        State &s = state();
+        if (s.saving)
+            tcsetattr(STDIN_FILENO, TCSANOW, &s.saved); // Async-signal-safe
+        signal(signalNumber, SIG_DFL);
+        raise(signalNumber);
+    }
+
+    static void installSignalHandlers()
+    {
+        static bool installed = false;
+        if (installed)
+            return;
+        installed = true;
+        for (int signalNumber : {SIGINT, SIGTERM, SIGHUP, SIGQUIT})
+        {
+            struct sigaction current;
+            if (sigaction(signalNumber, nullptr, &current) == 0 && current.sa_handler == SIG_DFL)
+                signal(signalNumber, restoreAndRaise); // Leave handlers installed by others alone
+        }
+    }
+
+    // One byte, waiting at most 'timeoutMs' (-1 = forever); -1 on timeout / end of input
+    static int readByte(int timeoutMs)
+    {
+        while (true)
+        {
+            if (timeoutMs >= 0)
+            {
+                pollfd input = {STDIN_FILENO, POLLIN, 0};
+                int ready = poll(&input, 1, timeoutMs);
+                if (ready < 0 && errno == EINTR)
+                    continue;
+                if (ready <= 0)
+                    return -1;
+            }
+
+            unsigned char c;
+            ssize_t n = ::read(STDIN_FILENO, &c, 1);
+            if (n == 1)
+                return c;
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n == 0)
+                state().closed = true;
+            return -1;
+        }
+    }
+
+    // After ESC: "[" or "O", optional numeric parameters, then a final byte
+    static KeyEvent readEscapeSequence()
+    {
+        int introducer = readByte(ESCAPE_TIMEOUT_MS);
+        if (introducer < 0)
+            return {Key::Escape}; // Nothing followed: the ESC key itself
+        if (introducer != '[' && introducer != 'O')
+            return {Key::Other}; // Alt + key
+
+        int parameter = 0;
+        bool firstParameter = true; // Later ones are modifiers (Shift / Ctrl + key): read as the plain key
+        while (true)
+        {
+            int c = readByte(ESCAPE_TIMEOUT_MS);
+            if (c < 0)
+                return {Key::Other}; // Truncated sequence
+            if (c >= '0' && c <= '9')
+            {
+                if (firstParameter)
+                    parameter = parameter * 10 + (c - '0');
+                continue;
+            }
+            if (c == ';')
+            {
+                firstParameter = false;
+                continue;
+            }
+
+            switch (c)
+            {
+            case 'A': return {Key::Up};
+            case 'B': return {Key::Down};
+            case 'C': return {Key::Right};
+            case 'D': return {Key::Left};
+            case 'H': return {Key::Home};
+            case 'F': return {Key::End};
+            case '~':
+                if (parameter == 1 || parameter == 7)
+                    return {Key::Home};
+                if (parameter == 4 || parameter == 8)
+                    return {Key::End};
+                if (parameter == 3)
+                    return {Key::Delete};
+                return {Key::Other};
+            default:
+                if (c >= 0x40 && c <= 0x7E)
+                    return {Key::Other}; // Some other final byte
+                break;                   // Intermediate byte: keep reading
+            }
+        }
+    }
+
+public:
+    // Terminal in raw mode while one of these is alive (nesting is fine);
+    // does nothing when stdin is not a terminal.
+    class RawMode
+    {
+    public:
+        RawMode()
+        {
+            State &s = state();
+            if (s.depth++ > 0 || tcgetattr(STDIN_FILENO, &s.saved) != 0)
+                return;
+
+            termios raw = s.saved;
+            raw.c_lflag &= ~(ICANON | ECHO | IEXTEN); // Keep ISIG: Ctrl+C still interrupts
+            raw.c_iflag &= ~(ICRNL | IXON);           // Enter arrives as '\r'; Ctrl+S / Ctrl+Q are keys
+            raw.c_cc[VMIN] = 1;
+            raw.c_cc[VTIME] = 0;
+            installSignalHandlers();
+            s.saving = true;
+            tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        }
+
+        ~RawMode()
+        {
+            State &s = state();
+            if (--s.depth == 0 && s.saving)
+            {
+                tcsetattr(STDIN_FILENO, TCSANOW, &s.saved);
+                s.saving = false;
+            }
+        }
+
+        RawMode(const RawMode &) = delete;
+        RawMode &operator=(const RawMode &) = delete;
+    };
+
+    // Wait for one key
+    static KeyEvent read()
+    {
+        RawMode raw; // Only switches the terminal if the caller did not already
+        int c = readByte(-1);
+        if (c < 0)
+            return {Key::Closed};
+        if (c == 27)
+            return readEscapeSequence();
+        return fromByte(c);
+    }
+
+    // Throw away keys typed ahead (never blocks; piped input is left alone)
+    static void drain() { tcflush(STDIN_FILENO, TCIFLUSH); }
+
+    // stdin has been closed (a menu should give up rather than wait forever)
+    static bool closed() { return state().closed; }
+
+#endif
+};
+
+#endif
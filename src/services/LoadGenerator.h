@@ -0,0 +1,314 @@
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/epoll.h>
+
+#include "../net/Socket.h"
+
+using namespace std;
+
+// How to load a server (see ServerService for the protocol)
+struct LoadOptions
+{
+    string address;           // Server address (see SocketAddress)
+    size_t connections = 16;  // Simulated desks
+    size_t requests = 100000; // In total, spread over the connections
+    size_t pipeline = 1;      // Requests in flight per connection (1 = wait for each reply)
+    int writePercent = 10;    // Share of add-member requests (the rest are lookups / searches / stats)
+    string email = "admin";   // Admin to log in as
+    string password = "123";
+};
+
+// What a load run measured
+struct LoadReport
+{
+    size_t requests = 0;
+    size_t errors = 0;          // ERR replies
+    double seconds = 0;
+    vector<uint64_t> latencies; // Nanoseconds per request, sorted
+
+    double requestsPerSecond() const { return seconds > 0 ? requests / seconds : 0; }
+
+    // Latency at 'fraction' (0.5 = median), in microseconds
+    double percentile(double fraction) const
+    {
+        if (latencies.empty())
+            return 0;
+        size_t index = min(latencies.size() - 1, (size_t)(fraction * latencies.size()));
+        return latencies[index] / 1000.0;
+    }
+};
+
+// LoadGenerator - simulates many desks against a running server
+// Every connection logs in, then keeps 'pipeline' requests in flight until its
+// share is answered. One thread drives all connections with epoll, and each
+// request's latency is measured from send to reply.
+class LoadGenerator
+{
+private:
+    using Clock = chrono::steady_clock;
+
+    struct InFlight
+    {
+        Clock::time_point sentAt;
+        bool adds; // add-member: the reply carries a new member ID
+    };
+
+    struct Client
+    {
+        Socket socket;
+        string input;  // Partial reply line
+        string output; // Requests not sent yet
+        deque<InFlight> inFlight;
+        size_t index = 0;  // Position among the connections (keeps emails unique)
+        size_t issued = 0;
+        size_t quota = 0;
+        bool writing = false; // Watching EPOLLOUT
+    };
+
+    // Send one line and wait for its reply (used for the login)
+    static bool exchange(Socket &socket, const string &request, string &reply)
+    {
+        if (send(socket.get(), request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size())
+            return false;
+        reply.clear();
+        char c;
+        while (recv(socket.get(), &c, 1, 0) == 1)
+        {
+            if (c == '\n')
+                return true;
+            reply += c;
+        }
+        return false;
+    }
+
+    // "<n> OK ..." -> true; the text after "OK " goes to 'value'
+    static bool parseReply(const string &line, string &value)
+    {
+        size_t space = line.find(' ');
+        if (space == string::npos || line.compare(space + 1, 2, "OK") != 0)
+            return false;
+        value = space + 4 <= line.size() ? line.substr(space + 4) : "";
+        return true;
+    }
+
+    // Reads are 60% lookups by ID, 30% searches and 10% stats
+    static void queueRequest(Client &client, const LoadOptions &options, mt19937 &random, int knownMembers,
+                             const string &runTag)
+    {
+        bool adds = (int)(random() % 100) < options.writePercent;
+        string &out = client.output;
+
+        if (adds)
+        {
+            string suffix = to_string(client.index) + "-" + to_string(client.issued);
+            out += "add-member \"Load " + suffix + "\" load-" + runTag + "-" + suffix + "@bench.local pw standard\n";
+        }
+        else
+        {
+            unsigned kind = random() % 10;
+            if (kind < 6)
+                out += "find-member " + to_string(1 + random() % knownMembers) + "\n";
+            else if (kind < 9)
+                out += "search-members " + string(1, (char)('a' + random() % 26)) + "\n";
+            else
+                out += "stats\n";
+        }
+
+        client.inFlight.push_back({Clock::now(), adds});
+        client.issued++;
+    }
+
+    static bool flushOutput(Client &client, int epollFd)
+    {
+        while (!client.output.empty())
+        {
+            ssize_t written = send(client.socket.get(), client.output.data(), client.output.size(), MSG_NOSIGNAL);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    return false;
+                break;
+            }
+            client.output.erase(0, (size_t)written);
+        }
+
+        bool wantWrite = !client.output.empty();
+        if (wantWrite != client.writing)
+        {
+            epoll_event event;
+            event.events = wantWrite ? EPOLLIN | EPOLLOUT : EPOLLIN;
+            event.data.fd = client.socket.get();
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, client.socket.get(), &event);
+            client.writing = wantWrite;
+        }
+        return true;
+    }
+
+public:
+    // Run the load; false + error if the server could not be reached / logged into
+    static bool run(const LoadOptions &options, LoadReport &report, string &error)
+    {
+        report = LoadReport();
+        SocketAddress address;
+        if (!SocketAddress::parse(options.address, address, error))
+            return false;
+        if (options.connections == 0 || options.pipeline == 0)
+        {
+            error = "Need at least one connection and one request in flight";
+            return false;
+        }
+
+        Socket epoll(epoll_create1(EPOLL_CLOEXEC));
+        if (!epoll.isOpen())
+        {
+            error = string("Cannot create epoll: ") + strerror(errno);
+            return false;
+        }
+
+        // --- Connect and log in (not measured) ---
+        vector<unique_ptr<Client>> clients;
+        vector<Client *> byFd;
+        string reply, value;
+        for (size_t i = 0; i < options.connections; i++)
+        {
+            unique_ptr<Client> client(new Client());
+            if (!client->socket.connectTo(address, error))
+                return false;
+            if (!exchange(client->socket, "login " + options.email + " " + options.password + "\n", reply) ||
+                !parseReply(reply, value))
+            {
+                error = "Login failed: " + reply;
+                return false;
+            }
+            client->socket.setNonBlocking();
+            client->index = i;
+            client->quota = options.requests / options.connections + (i < options.requests % options.connections);
+
+            int fd = client->socket.get();
+            epoll_event event;
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epoll.get(), EPOLL_CTL_ADD, fd, &event);
+            if ((size_t)fd >= byFd.size())
+                byFd.resize(fd + 1, nullptr);
+            byFd[fd] = client.get();
+            clients.push_back(std::move(client));
+        }
+
+        // --- Measured run ---
+        mt19937 random(12345);
+        string runTag = to_string(Clock::now().time_since_epoch().count() % 1000000007);
+        int knownMembers = 3; // The test data always has members 1..3
+        report.latencies.reserve(options.requests);
+        size_t remaining = options.requests;
+
+        auto started = Clock::now();
+        for (size_t i = 0; i < clients.size(); i++)
+        {
+            Client &client = *clients[i];
+            while (client.issued < client.quota && client.inFlight.size() < options.pipeline)
+                queueRequest(client, options, random, knownMembers, runTag);
+            if (!flushOutput(client, epoll.get()))
+            {
+                error = "Connection lost";
+                return false;
+            }
+        }
+
+        epoll_event events[64];
+        char buffer[64 * 1024];
+        while (remaining > 0)
+        {
+            int ready = epoll_wait(epoll.get(), events, 64, 10000);
+            if (ready == 0)
+            {
+                error = "Server stopped answering";
+                return false;
+            }
+            for (int e = 0; e < ready; e++)
+            {
+                int fd = events[e].data.fd;
+                Client &client = *byFd[fd];
+
+                if ((events[e].events & EPOLLOUT) && !flushOutput(client, epoll.get()))
+                {
+                    error = "Connection lost";
+                    return false;
+                }
+                if (!(events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+                    continue;
+
+                ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                if (received < 0 && (errno == EAGAIN || errno == EINTR))
+                    continue;
+                if (received <= 0)
+                {
+                    error = "Server closed the connection";
+                    return false;
+                }
+
+                client.input.append(buffer, (size_t)received);
+                size_t start = 0, end;
+                Clock::time_point now = Clock::now();
+                while ((end = client.input.find('\n', start)) != string::npos)
+                {
+                    string line = client.input.substr(start, end - start);
+                    start = end + 1;
+                    if (client.inFlight.empty())
+                        continue; // Unexpected extra line
+
+                    InFlight request = client.inFlight.front();
+                    client.inFlight.pop_front();
+                    report.latencies.push_back((uint64_t)chrono::duration_cast<chrono::nanoseconds>(now - request.sentAt).count());
+                    report.requests++;
+                    remaining--;
+
+                    if (!parseReply(line, value))
+                        report.errors++;
+                    else if (request.adds)
+                        knownMembers = max(knownMembers, atoi(value.c_str()));
+                }
+                client.input.erase(0, start);
+
+                while (client.issued < client.quota && client.inFlight.size() < options.pipeline)
+                    queueRequest(client, options, random, knownMembers, runTag);
+                if (!flushOutput(client, epoll.get()))
+                {
+                    error = "Connection lost";
+                    return false;
+                }
+            }
+        }
+        report.seconds = chrono::duration<double>(Clock::now() - started).count();
+
+        sort(report.latencies.begin(), report.latencies.end());
+        return true;
+    }
+
+    static void print(const LoadReport &report, const LoadOptions &options, ostream &out)
+    {
+        out << "# " << options.address << ": " << options.connections << " connections, pipeline "
+            << options.pipeline << ", " << options.writePercent << "% writes" << endl;
+        out << "# " << report.requests << " requests, " << report.errors << " errors, " << fixed << setprecision(3)
+            << report.seconds << " s (" << setprecision(0) << report.requestsPerSecond() << " requests/s)" << endl;
+        out << "# latency us: p50 " << setprecision(1) << report.percentile(0.50) << "  p90 " << report.percentile(0.90)
+            << "  p99 " << report.percentile(0.99) << "  p99.9 " << report.percentile(0.999) << "  max "
+            << report.percentile(1.0) << endl;
+    }
+};
+
+#endif
@@ -5,63 +5,93 @@
 #include <vector>
 #include <string>
 
+#include "../core/GymEngine.h"
 #include "../entities/Member.h"
 #include "../services/ConsoleUI.h"
-#include "../services/TrainerService.h"
+#include "../services/SearchPrompt.h"
+#include "../services/RowCache.h"
+#include "../services/SortCache.h"
+#include "../services/TableView.h"
 
 using namespace std;
 
-// MemberService class - handles member operations with UI
+// MemberService class - console front-end for member operations
+// All data and rules live in GymEngine; this class only asks and prints.
+// The engine's read lock is held only while a screen is drawn, never while
+// waiting for the user, so other threads are not blocked by an open menu.
 class MemberService
 {
 private:
-    // Vector to store members in memory (shared across all instances)
-    static vector<Member *> members;
-    static bool initialized;
+    GymEngine &engine;
+    RowCache memberRows; // Listing rows: ID, name, email, join date, subscription
+    SortCache<Member> memberOrders; // "View All Members" orders, one per column
+    size_t sortColumn = 0;          // Kept between visits to the screen
+    bool sortDescending = false;
+
+    // Add or Update Member Helper - Report an invalid subscription type
+    static void printInvalidSubscriptionType()
+    {
+        ConsoleUI::printError("Invalid Subscription Type!");
+        ConsoleUI::printInfo("Allowed: " + string(SUBSCRIPTION_ALIASES_HELP));
+        ConsoleUI::pause();
+    }
 
-    // Initialize with fake members for testing
-    void initialize()
+    // Report a failed engine operation
+    static void printFailure(EngineStatus status)
     {
-        if (!initialized)
+        if (status == EngineStatus::InvalidSubscription)
         {
-            // Create fake members using add method (IDs auto-assigned)
-            Member *m1 = new Member("Mohamed", "mohamed@gmail.com", "123", "2024-01-15");
-            m1->setSubscriptionId(1);
-            members.push_back(m1);
-
-            Member *m2 = new Member("Ahmed", "ahmed@gmail.com", "123", "2024-02-20");
-            m2->setSubscriptionId(2);
-            members.push_back(m2);
+            printInvalidSubscriptionType();
+            return;
+        }
+        ConsoleUI::printError(string(engineStatusMessage(status)) + "!");
+        if (status == EngineStatus::JournalFailed)
+            ConsoleUI::printInfo("Nothing was changed: the data files could not be written (disk full?)");
+        ConsoleUI::pause();
+    }
 
-            Member *m3 = new Member("Mostafa", "mostafa@gmail.com", "123", "2024-03-10");
-            m3->setSubscriptionId(1);
-            members.push_back(m3);
+    // Name of a member, copied out under the read lock (false if not found)
+    bool memberName(int id, string &name) const
+    {
+        GymEngine::ReadGuard guard = engine.readLock();
+        const Member *member = engine.findMember(id);
+        if (member == nullptr)
+            return false;
+        name = member->getName();
+        return true;
+    }
 
-            initialized = true;
-        }
+    // How "View All Members" sorts by each of its columns
+    static vector<SortCache<Member>::Compare> memberSortColumns()
+    {
+        using Sort = SortCache<Member>;
+        return {
+            [](const Member &a, const Member &b) { return Sort::compareNumbers(a.getId(), b.getId()); },
+            [](const Member &a, const Member &b) { return Sort::compareText(a.getName(), b.getName()); },
+            [](const Member &a, const Member &b) { return Sort::compareText(a.getEmail(), b.getEmail()); },
+            [](const Member &a, const Member &b)
+            { return Sort::compareNumbers(a.getJoinDate().daysSinceEpoch(), b.getJoinDate().daysSinceEpoch()); },
+            [](const Member &a, const Member &b)
+            { return Sort::compareNumbers(a.getSubscriptionId(), b.getSubscriptionId()); }};
     }
 
-    // Add or Update Member Helper - Normalize subscription type
-    string getNormalizedSubscriptionType(const string &type)
+    // Listing row of a member, formatted again only after it changed
+    // (hold the engine's read lock)
+    const TableRow &memberRow(const Member &member)
     {
-        string lowerType = ConsoleUI::toLower(type);
-        if (lowerType == "standard" || lowerType == "std" || lowerType == "s" || lowerType == "1")
+        return memberRows.get(member.getId(), member.getRevision(), [&](TableRow &row)
         {
-            return "Standard";
-        }
-        else if (lowerType == "premium" || lowerType == "prem" || lowerType == "p" || lowerType == "2")
-        {
-            return "Premium";
-        }
-        return "Unknown";
+            row.add(to_string(member.getId()));
+            row.add(member.getName());
+            row.add(member.getEmail());
+            row.add(member.getJoinDate().toString());
+            row.add(member.getSubscriptionName());
+        });
     }
 
 public:
     // Constructor
-    MemberService()
-    {
-        initialize();
-    }
+    MemberService(GymEngine &gymEngine) : engine(gymEngine), memberOrders(memberSortColumns()) {}
 
     // Add new member with UI
     void addMember()
@@ -73,79 +103,133 @@ public:
         if (data.empty())
             return; // ESC Pressed: Cancelled
 
-        // Validate subscription type
-        string typeInput = getNormalizedSubscriptionType(data[3]);
+        // Validation happens in the engine (type, unique email)
+        SubscriptionType type = parseSubscriptionType(data[3]);
+        EngineResult<int> result = engine.addMember(data[0], data[1], data[2], type);
 
-        if (typeInput == "Unknown")
+        if (!result.ok())
         {
-            ConsoleUI::printError("Invalid Subscription Type!");
-            ConsoleUI::printInfo("Allowed: Standard (s, std, 1), Premium (p, prem, 2)");
-            ConsoleUI::pause();
-            return; // Cancel the operation, don't save
+            printFailure(result.status);
+            return; // Nothing was saved
         }
 
-        Member *newMember = new Member(data[0], data[1], data[2]);
-
-        // Set the ID logic
-        if (typeInput == "Standard")
-            newMember->setSubscriptionId(1);
-        else
-            newMember->setSubscriptionId(2);
-
-        // Store
-        members.push_back(newMember);
-
         ConsoleUI::printSuccess("Member added successfully!");
-        ConsoleUI::printInfo("Member ID: " + to_string(newMember->getId()));
-        ConsoleUI::printInfo("Type: " + typeInput); // Show them what we saved
+        ConsoleUI::printInfo("Member ID: " + to_string(result.value));
+        ConsoleUI::printInfo("Type: " + string(subscriptionTypeName(type))); // Show them what we saved
         ConsoleUI::pause();
     }
 
-    // View all members with UI
+    // View all members with UI, one page at a time, sorted by any column
     void viewAllMembers()
     {
-        ConsoleUI::printHeader("All Members");
+        TableView table({"ID", "Name", "Email", "Join Date", "Subscription"});
+        table.setSortColumn(sortColumn, sortDescending);
+        table.browse("All Members", "members", "No members found!", [&](size_t first, size_t count)
+        {
+            // The cached order is repaired from what changed since the last page
+            GymEngine::ReadGuard guard = engine.readLock();
+            const SlotMap<Member> &members = engine.getMembers();
+            const vector<Handle<Member>> &order = memberOrders.sorted(members, sortColumn, engine.revision());
+            size_t stop = min(order.size(), first + count);
+            for (size_t i = first; i < stop; i++)
+                table.addRow(memberRow(*members.get(order[sortDescending ? order.size() - 1 - i : i])));
+
+            memberRows.trim(members.size(), [&](int id) { return engine.findMember(id) != nullptr; });
+            return order.size();
+        },
+        "sr", "[S] Sort by next column  [R] Reverse", [&](char key)
+        {
+            if (key == 's')
+            {
+                sortColumn = (sortColumn + 1) % memberOrders.columnCount();
+                sortDescending = false;
+            }
+            else
+                sortDescending = !sortDescending;
+            table.setSortColumn(sortColumn, sortDescending);
+        });
+    }
+
+    // View members of one subscription type with UI (scans the column store)
+    void viewMembersBySubscription()
+    {
+        string input = ConsoleUI::getInput("Enter subscription type to filter by: ");
+        SubscriptionType type = parseSubscriptionType(input);
 
-        if (members.empty())
+        if (type == SubscriptionType::Unknown)
         {
-            ConsoleUI::printWarning("No members found!");
+            printInvalidSubscriptionType();
             return;
         }
 
-        vector<string> headers = {"ID", "Name", "Email", "Join Date", "Subscription"};
-        vector<int> widths = {8, 20, 25, 12, 15};
+        // The matching IDs are scanned once for the screen, and again only
+        // after the members changed (their rows may be gone by then)
+        string title = string(subscriptionTypeName(type)) + " Members";
+        TableView table({"ID", "Name", "Email", "Join Date"});
+        vector<int> ids;
+        uint64_t scannedAt = 0;
+        bool scanned = false;
+        table.browse(title, "members", "No members found!", [&](size_t first, size_t count)
+        {
+            GymEngine::ReadGuard guard = engine.readLock();
+            if (!scanned || scannedAt != engine.revision())
+            {
+                ids = engine.getMemberColumns().filterBySubscription(type);
+                scannedAt = engine.revision();
+                scanned = true;
+            }
+            size_t stop = min(ids.size(), first + count);
+            for (size_t i = first; i < stop; i++)
+                table.addRow(memberRow(*engine.findMember(ids[i])), 4); // Without the subscription
+            return ids.size();
+        });
+    }
 
-        ConsoleUI::printTableHeader(headers, widths);
+    // View members who joined in a date range with UI, one page at a time
+    void viewMembersByJoinDate()
+    {
+        vector<string> data = ConsoleUI::getFormData("MEMBERS BY JOIN DATE",
+                                                     {"From (YYYY-MM-DD)", "To (YYYY-MM-DD)"});
 
-        for (const Member *member : members)
+        if (data.empty())
+            return; // ESC Pressed: Cancelled
+
+        Date from, to;
+        if (!Date::parse(data[0], from) || !Date::parse(data[1], to))
         {
-            vector<string> row = {
-                to_string(member->getId()),
-                member->getName(),
-                member->getEmail(),
-                member->getJoinDate(),
-                member->getSubscriptionType()
-            };
-            ConsoleUI::printTableRow(row, widths);
+            ConsoleUI::printError("Invalid date! Use YYYY-MM-DD.");
+            ConsoleUI::pause();
+            return;
         }
-        ConsoleUI::pause();
+
+        // Only the rows of the current page are looked up and formatted
+        // The range is a view, so it is taken again under the lock for every page.
+        string title = "Joined " + from.toString() + " to " + to.toString();
+        TableView table({"ID", "Name", "Email", "Join Date", "Subscription"});
+        table.browse(title, "members", "No members joined in this period!", [&](size_t first, size_t count)
+        {
+            GymEngine::ReadGuard guard = engine.readLock();
+            JoinDateRange range = engine.findMembersJoinedBetween(from, to);
+            for (const JoinDateEntry &entry : range.page(first / count, count))
+                table.addRow(memberRow(*engine.findMember(entry.id)));
+            return range.size();
+        });
     }
 
     // Update member with UI
     void updateMember()
     {
-        if (members.empty())
+        if (engine.memberCount() == 0)
         {
             ConsoleUI::printWarning("No members to update!");
             return;
         }
 
-        // Use simple input for ID
-        int id = ConsoleUI::getIntInput("\nEnter member ID to update: ");
+        // ID, or a name / email fragment to search for
+        int id = SearchPrompt::pickId("Enter member ID, name or email to update: ", "SELECT MEMBER", engine, engine.getMemberSearch());
 
-        Member *member = findMemberById(id);
-
-        if (member == nullptr)
+        string name;
+        if (!memberName(id, name))
         {
             ConsoleUI::printError("Member not found!");
             return;
@@ -153,30 +237,21 @@ public:
 
         // Use the New Arrow Menu UI
         vector<string> opts = {"Update Subscription Type", "Cancel"};
-        int choice = ConsoleUI::getMenuSelection("UPDATE MEMBER: " + member->getName(), opts);
+        int choice = ConsoleUI::getMenuSelection("UPDATE MEMBER: " + name, opts);
 
         if (choice == 0)
         {
-            int subId = 0;
             string inputSubscriptionType = ConsoleUI::getInput("Enter new subscription type: ");
 
-            // Validate subscription type
-            string subscriptionType = getNormalizedSubscriptionType(inputSubscriptionType);
+            SubscriptionType type = parseSubscriptionType(inputSubscriptionType);
+            EngineStatus status = engine.changeSubscription(id, type);
 
-            if (subscriptionType == "Unknown")
+            if (status != EngineStatus::Ok)
             {
-                ConsoleUI::printError("Invalid Subscription Type!");
-                ConsoleUI::printInfo("Allowed: Standard (s, std, 1), Premium (p, prem, 2)");
-                ConsoleUI::pause();
-                return; // Cancel the operation, don't save
+                printFailure(status);
+                return; // Nothing was saved
             }
 
-            // Set the ID logic
-            if (subscriptionType == "Standard")
-                member->setSubscriptionId(1);
-            else
-                member->setSubscriptionId(2);
-
             ConsoleUI::printSuccess("Subscription updated!");
         }
         else
@@ -192,65 +267,36 @@ public:
     {
         ConsoleUI::printHeader("Delete Member");
 
-        if (members.empty())
+        if (engine.memberCount() == 0)
         {
             ConsoleUI::printWarning("No members to delete!");
             ConsoleUI::pause();
             return;
         }
 
-        int id = ConsoleUI::getIntInput("Enter member ID to delete: ");
+        int id = SearchPrompt::pickId("Enter member ID, name or email to delete: ", "SELECT MEMBER", engine, engine.getMemberSearch());
 
-        for (auto it = members.begin(); it != members.end(); ++it)
+        string name;
+        if (!memberName(id, name))
         {
-            if ((*it)->getId() == id)
-            {
-                string name = (*it)->getName();
-
-                // --- CASCADING DELETE ---
-                // Before deleting the member from memory, remove them from any Trainers.
-                TrainerService::removeMemberFromAllTrainers(id);
-
-                delete *it;
-                members.erase(it);
-                ConsoleUI::printSuccess("Member '" + name + "' deleted successfully!");
-                ConsoleUI::pause();
-                return;
-            }
+            ConsoleUI::printError("Member not found!");
+            ConsoleUI::pause();
+            return;
         }
-
-        ConsoleUI::printError("Member not found!");
-        ConsoleUI::pause();
-    }
-
-    // Find member by ID (internal use)
-    Member *findMemberById(int id)
-    {
-        for (Member *member : members)
+        int unassigned = 0;
+        EngineStatus status = engine.deleteMember(id, &unassigned);
+        if (status != EngineStatus::Ok)
         {
-            if (member->getId() == id)
-            {
-                return member;
-            }
+            printFailure(status);
+            return;
         }
-        return nullptr;
-    }
 
-    // Check if members exist
-    bool isEmpty()
-    {
-        return members.empty();
-    }
+        if (unassigned > 0)
+            ConsoleUI::printInfo("Member removed from " + to_string(unassigned) + " trainer(s).");
 
-    // Get all members (for trainer assignment)
-    vector<Member *> getAllMembers()
-    {
-        return members;
+        ConsoleUI::printSuccess("Member '" + name + "' deleted successfully!");
+        ConsoleUI::pause();
     }
 };
 
-// Initialize static members
-vector<Member *> MemberService::members;
-bool MemberService::initialized = false;
-
 #endif
@@ -0,0 +1,137 @@
+#ifndef PERSISTENCE_SERVICE_H
+#define PERSISTENCE_SERVICE_H
+
+#include <string>
+
+#include "../core/GymEngine.h"
+#include "../storage/Snapshot.h"
+#include "../storage/WriteAheadLog.h"
+
+using namespace std;
+
+// PersistenceService - saves / restores the engine's data
+// - Snapshot: full binary image, written on Exit
+// - Write-ahead log: every mutation since the last snapshot, replayed on startup
+// Nothing is saved until load() has succeeded: after a failed load the engine
+// holds only part of the data (or the test data), and saving it would replace
+// the files that could not be read. The same goes after discardLog().
+class PersistenceService
+{
+private:
+    GymEngine &engine;
+    string snapshotPath;
+    string logPath;
+    WriteAheadLog log;
+    bool loaded = false;    // load() succeeded: saving is allowed
+    bool discarded = false; // discardLog() dropped changes that memory still holds
+
+public:
+    static constexpr const char *DEFAULT_SNAPSHOT_PATH = "elforma.snapshot";
+
+    PersistenceService(GymEngine &gymEngine, string path = DEFAULT_SNAPSHOT_PATH)
+        : engine(gymEngine), snapshotPath(std::move(path)), logPath(snapshotPath + ".wal") {}
+
+    ~PersistenceService()
+    {
+        engine.setJournal(nullptr);
+        log.close(); // Flushes any pending group
+    }
+
+    const string &getSnapshotPath() const { return snapshotPath; }
+    const string &getLogPath() const { return logPath; }
+
+    // Group commit: fsync once per 'records' mutations or once 'delayMs' old
+    // (1, 0 = fsync every mutation; bulk jobs raise it and call commitLog()).
+    void setGroupCommit(size_t records, int delayMs)
+    {
+        log.setGroupCommit(records, delayMs);
+    }
+
+    // Force pending log records to disk
+    bool commitLog()
+    {
+        return log.commit();
+    }
+
+    // Give up on log records that failed to commit (their changes were
+    // reported as failed). Memory still holds them, so saving is refused.
+    void discardLog()
+    {
+        log.discardPending();
+        discarded = true;
+    }
+
+    bool hasSnapshot() const
+    {
+        return SnapshotReader::exists(snapshotPath);
+    }
+
+    // Load the snapshot, replay the log on top of it and start logging
+    // (false + error if something is unreadable). A missing snapshot is not an
+    // error: the log is replayed on top of the engine's test data.
+    bool load(string &error)
+    {
+        loaded = false;
+        discarded = false;
+        engine.setJournal(nullptr); // Replaying must not log the records again
+
+        uint64_t snapshotSequence = 0;
+        if (hasSnapshot())
+        {
+            SnapshotReader reader;
+            if (!reader.open(snapshotPath, error))
+                return false;
+
+            engine.loadFrom(reader);
+            snapshotSequence = reader.lastSequence();
+        }
+
+        uint64_t lastSequence = 0;
+        bool replayed = WriteAheadLog::replay(logPath, snapshotSequence, [this](WalRecord &record) {
+            engine.applyLogRecord(record);
+        }, lastSequence, error);
+
+        if (!replayed || !log.open(logPath, lastSequence, error))
+            return false;
+
+        engine.setJournal(&log);
+        loaded = true;
+        return true;
+    }
+
+    bool isLoaded() const { return loaded; }
+
+    // Save the engine's data (false + error on failure)
+    // Writers wait until the log is reset, so nothing logged is lost in between.
+    bool save(string &error)
+    {
+        if (!loaded)
+        {
+            error = "The saved data was not loaded; " + snapshotPath + " is left as it is";
+            return false;
+        }
+        if (discarded)
+        {
+            error = "Changes could not be written to " + logPath + "; " + snapshotPath + " is left as it is";
+            return false;
+        }
+
+        GymEngine::ReadGuard guard = engine.readLock();
+        SnapshotWriter writer;
+        writer.setLastSequence(log.lastSequence());
+        engine.saveTo(writer);
+
+        if (!writer.save(snapshotPath, error))
+            return false;
+
+        // Everything logged so far is in the snapshot now
+        if (!log.reset())
+        {
+            error = "Cannot reset " + logPath;
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif
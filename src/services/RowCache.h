@@ -0,0 +1,74 @@
+#ifndef ROW_CACHE_H
+#define ROW_CACHE_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "TableView.h"
+
+using namespace std;
+
+// RowCache - table rows formatted once per member / trainer revision
+// A row is kept with the revision of the entity it was formatted from. The
+// engine gives an entity a new revision whenever it changes (an update, an
+// assignment, a reload; see GymEngine::touch), whichever front-end changed it,
+// so a cached row is used only while it still matches. Listing a page again
+// then copies the cached cells instead of formatting every field.
+// Use it under the engine's read lock, from one thread.
+class RowCache
+{
+private:
+    struct Entry
+    {
+        uint64_t revision = 0; // Of the entity when 'row' was formatted
+        TableRow row;
+    };
+
+    unordered_map<int, Entry> rows; // Entity ID -> its last formatted row
+    size_t hits = 0;
+    size_t misses = 0;
+
+public:
+    // The row of entity 'id' at 'revision'; 'format(row)' fills it again when
+    // the cached one is from an older revision (or there is none)
+    template <typename Format>
+    const TableRow &get(int id, uint64_t revision, Format format)
+    {
+        auto it = rows.find(id);
+        if (it != rows.end() && it->second.revision == revision)
+        {
+            hits++;
+            return it->second.row;
+        }
+
+        misses++;
+        Entry &entry = it != rows.end() ? it->second : rows[id];
+        entry.row.cells.clear(); // Keeps its capacity
+        entry.row.ends.clear();
+        format(entry.row);
+        entry.revision = revision;
+        return entry.row;
+    }
+
+    // Drop the rows of deleted entities ('exists(id)' is false), but only once
+    // the cache has grown to twice 'liveCount' rows, so the sweep stays rare
+    template <typename Exists>
+    void trim(size_t liveCount, Exists exists)
+    {
+        if (rows.size() <= 2 * liveCount + 64)
+            return;
+        for (auto it = rows.begin(); it != rows.end();)
+        {
+            if (exists(it->first))
+                ++it;
+            else
+                it = rows.erase(it);
+        }
+    }
+
+    size_t size() const { return rows.size(); }
+    size_t hitCount() const { return hits; }
+    size_t missCount() const { return misses; }
+};
+
+#endif
@@ -0,0 +1,355 @@
+#ifndef SCREEN_BUFFER_H
+#define SCREEN_BUFFER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// ScreenBuffer - differential full-screen renderer
+// A frame is drawn into a grid of cells, then present() compares it with the
+// frame already on the terminal and sends only the cells that changed, as
+// ANSI escape sequences, in one write. Moving a menu highlight sends two short
+// lines instead of clearing and redrawing the whole screen.
+//
+// Anything printed around it (cout) leaves the terminal unknown: call
+// invalidate() (or clearScreen()) and the next present() repaints everything.
+class ScreenBuffer
+{
+public:
+    // Foreground colors (the values are the ANSI SGR codes)
+    enum class Color : uint8_t
+    {
+        Default = 0,
+        Red = 31,
+        Green = 32,
+        Cyan = 96
+    };
+
+private:
+    static const int DEFAULT_ROWS = 24;
+    static const int DEFAULT_COLS = 80;
+    static const int MAX_SKIP = 4; // Unchanged cells re-sent rather than jumped over with a cursor move
+
+    struct Cell
+    {
+        char32_t ch = ' ';
+        Color color = Color::Default;
+
+        bool operator==(const Cell &other) const { return ch == other.ch && color == other.color; }
+        bool operator!=(const Cell &other) const { return !(*this == other); }
+    };
+
+    int rows = 0;
+    int cols = 0;
+    vector<Cell> frame; // Being drawn
+    vector<Cell> shown; // On the terminal (when 'valid')
+    bool valid = false;
+
+    int row = 0; // Draw position
+    int col = 0;
+    int cursorRow = 0; // Where the terminal cursor is left, when visible
+    int cursorCol = 0;
+    bool cursorVisible = false;
+    int shownCursorRow = -1; // Where present() left it
+    int shownCursorCol = -1;
+    bool shownCursorVisible = true;
+
+    string out; // Bytes of one present() (reused)
+
+    static void appendUtf8(string &bytes, char32_t ch)
+    {
+        if (ch < 0x80)
+            bytes += (char)ch;
+        else if (ch < 0x800)
+        {
+            bytes += (char)(0xC0 | (ch >> 6));
+            bytes += (char)(0x80 | (ch & 0x3F));
+        }
+        else if (ch < 0x10000)
+        {
+            bytes += (char)(0xE0 | (ch >> 12));
+            bytes += (char)(0x80 | ((ch >> 6) & 0x3F));
+            bytes += (char)(0x80 | (ch & 0x3F));
+        }
+        else
+        {
+            bytes += (char)(0xF0 | (ch >> 18));
+            bytes += (char)(0x80 | ((ch >> 12) & 0x3F));
+            bytes += (char)(0x80 | ((ch >> 6) & 0x3F));
+            bytes += (char)(0x80 | (ch & 0x3F));
+        }
+    }
+
+    // Next code point of UTF-8 'text' at 'i' ('?' for a malformed byte)
+    static char32_t nextCodePoint(string_view text, size_t &i)
+    {
+        unsigned char lead = (unsigned char)text[i++];
+        if (lead < 0x80)
+            return lead;
+        int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1;
+        if (extra < 0 || i + extra > text.size())
+            return '?';
+        char32_t ch = lead & (0x3F >> extra);
+        for (int k = 0; k < extra; k++)
+        {
+            unsigned char next = (unsigned char)text[i];
+            if ((next & 0xC0) != 0x80)
+                return '?';
+            ch = (ch << 6) | (next & 0x3F);
+            i++;
+        }
+        return ch;
+    }
+
+    void appendMove(int toRow, int toCol)
+    {
+        out += "\033[";
+        out += to_string(toRow + 1);
+        out += ';';
+        out += to_string(toCol + 1);
+        out += 'H';
+    }
+
+    void appendColor(Color color)
+    {
+        out += "\033[";
+        out += to_string((int)color);
+        out += 'm';
+    }
+
+public:
+    // Rows and columns of the terminal window (24 x 80 when it cannot be asked)
+    static void terminalSize(int &height, int &width)
+    {
+        height = DEFAULT_ROWS;
+        width = DEFAULT_COLS;
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info))
+        {
+            height = info.srWindow.Bottom - info.srWindow.Top + 1;
+            width = info.srWindow.Right - info.srWindow.Left + 1;
+        }
+#else
+        winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0)
+        {
+            height = size.ws_row;
+            width = size.ws_col;
+        }
+#endif
+    }
+
+    // Send bytes to the terminal in one go (after anything cout still holds)
+    static void writeOut(const string &bytes)
+    {
+        fflush(stdout);
+#ifdef _WIN32
+        DWORD written;
+        WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), bytes.data(), (DWORD)bytes.size(), &written, nullptr);
+#else
+        size_t sent = 0;
+        while (sent < bytes.size())
+        {
+            ssize_t n = ::write(STDOUT_FILENO, bytes.data() + sent, bytes.size() - sent);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return;
+            sent += (size_t)n;
+        }
+#endif
+    }
+
+    ScreenBuffer()
+    {
+#ifdef _WIN32
+        // Let the Windows console interpret the escape sequences
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode;
+        if (GetConsoleMode(console, &mode))
+            SetConsoleMode(console, mode | 0x0004); // ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#endif
+    }
+
+    ScreenBuffer(const ScreenBuffer &) = delete;
+    ScreenBuffer &operator=(const ScreenBuffer &) = delete;
+
+    int height() const { return rows; }
+    int width() const { return cols; }
+
+    // Start a new, blank frame (picks up a resized terminal)
+    void begin()
+    {
+        int height, width;
+        terminalSize(height, width);
+        if (height != rows || width != cols)
+        {
+            rows = height;
+            cols = width;
+            shown.assign((size_t)rows * cols, Cell());
+            valid = false;
+        }
+        frame.assign((size_t)rows * cols, Cell());
+        row = col = 0;
+        cursorVisible = false;
+    }
+
+    // Draw position (0-based); text outside the screen is clipped
+    void moveTo(int toRow, int toCol)
+    {
+        row = toRow;
+        col = toCol;
+    }
+
+    int currentRow() const { return row; }
+    int currentColumn() const { return col; }
+
+    // Draw UTF-8 text at the draw position; '\n' starts the next line
+    void print(string_view text, Color color = Color::Default)
+    {
+        size_t i = 0;
+        while (i < text.size())
+        {
+            char32_t ch = nextCodePoint(text, i);
+            if (ch == '\n')
+            {
+                row++;
+                col = 0;
+                continue;
+            }
+            if (row >= 0 && row < rows && col >= 0 && col < cols)
+                frame[(size_t)row * cols + col] = {ch, color};
+            col++;
+        }
+    }
+
+    // 'count' copies of one character (rules, padding)
+    void repeat(char ch, int count, Color color = Color::Default)
+    {
+        for (int i = 0; i < count; i++)
+            print(string_view(&ch, 1), color);
+    }
+
+    // Leave the terminal cursor here after present() (hidden otherwise)
+    void placeCursor(int atRow, int atCol)
+    {
+        cursorRow = atRow;
+        cursorCol = atCol;
+        cursorVisible = true;
+    }
+
+    // The terminal no longer shows the last frame: repaint it all next time
+    void invalidate() { valid = false; }
+
+    // Blank the terminal now (cursor home and visible), e.g. before cout output
+    void clearScreen()
+    {
+        out = "\033[0m\033[H\033[2J\033[?25h";
+        writeOut(out);
+        shownCursorVisible = true;
+        shownCursorRow = -1;
+        valid = false;
+    }
+
+    // Send what changed since the last frame, in one write
+    void present()
+    {
+        out.clear();
+        if (!valid)
+        {
+            out += "\033[0m\033[H\033[2J"; // Repaint everything from a blank screen
+            shown.assign(frame.size(), Cell());
+            shownCursorRow = -1;
+        }
+        size_t cellsStart = out.size();
+
+        Color color = Color::Default; // After "\033[0m" or the previous present()
+        int atRow = -1, atCol = -1;   // Terminal cursor (-1 = unknown)
+        for (int r = 0; r < rows; r++)
+        {
+            for (int c = 0; c < cols; c++)
+            {
+                size_t index = (size_t)r * cols + c;
+                const Cell &cell = frame[index];
+                if (cell == shown[index])
+                    continue;
+
+                // Short runs of unchanged cells in the same color are cheaper to re-send
+                if (r == atRow && c > atCol && c - atCol <= MAX_SKIP)
+                {
+                    size_t from = (size_t)r * cols + atCol;
+                    bool sameColor = true;
+                    for (size_t k = from; k < index && sameColor; k++)
+                        sameColor = frame[k].color == color;
+                    if (sameColor)
+                    {
+                        for (size_t k = from; k < index; k++)
+                            appendUtf8(out, frame[k].ch);
+                        atCol = c;
+                    }
+                }
+                if (r != atRow || c != atCol)
+                    appendMove(r, c);
+                if (cell.color != color)
+                {
+                    if (color != Color::Default && cell.color == Color::Default)
+                        out += "\033[0m";
+                    else
+                        appendColor(cell.color);
+                    color = cell.color;
+                }
+                appendUtf8(out, cell.ch);
+                shown[index] = cell;
+                atRow = r;
+                atCol = c + 1;
+                if (atCol >= cols)
+                    atRow = -1; // Pending wrap: position it explicitly next time
+            }
+        }
+        if (color != Color::Default)
+            out += "\033[0m";
+
+        bool cellsChanged = out.size() > cellsStart;
+        if (cellsChanged && shownCursorVisible)
+            out.insert(cellsStart, "\033[?25l"); // No cursor flicker while cells are written
+
+        if (cursorVisible)
+        {
+            if (cellsChanged || cursorRow != shownCursorRow || cursorCol != shownCursorCol)
+                appendMove(cursorRow, cursorCol);
+            if (cellsChanged || !shownCursorVisible)
+                out += "\033[?25h";
+            shownCursorRow = cursorRow;
+            shownCursorCol = cursorCol;
+        }
+        else
+        {
+            if (!cellsChanged && shownCursorVisible)
+                out += "\033[?25l";
+            shownCursorRow = -1;
+        }
+        shownCursorVisible = cursorVisible;
+        valid = true;
+
+        if (!out.empty())
+            writeOut(out);
+    }
+
+    // Bytes sent by the last present() (to measure what a redraw costs)
+    size_t lastPresentBytes() const { return out.size(); }
+};
+
+#endif
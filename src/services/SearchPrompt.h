@@ -0,0 +1,75 @@
+#ifndef SEARCH_PROMPT_H
+#define SEARCH_PROMPT_H
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "../core/GymEngine.h"
+#include "../services/ConsoleUI.h"
+#include "../storage/SearchIndex.h"
+
+using namespace std;
+
+// SearchPrompt - lets staff pick a member / trainer by ID, name or email
+class SearchPrompt
+{
+private:
+    static bool isNumber(const string &text)
+    {
+        if (text.empty() || text.size() > 9)
+            return false;
+        for (char c : text)
+        {
+            if (!isdigit((unsigned char)c))
+                return false;
+        }
+        return true;
+    }
+
+    static string trim(const string &text)
+    {
+        size_t first = text.find_first_not_of(" \t");
+        if (first == string::npos)
+            return "";
+        size_t last = text.find_last_not_of(" \t");
+        return text.substr(first, last - first + 1);
+    }
+
+public:
+    // Ask for an ID or a (partial, possibly misspelled) name / email
+    // A number is taken as the ID; otherwise the best matches are searched and,
+    // if there is more than one, shown in a menu to choose from.
+    // Returns the chosen ID, or -1 if nothing matched or the user cancelled.
+    // 'index' belongs to 'engine'; it is only read under the engine's read lock.
+    static int pickId(const string &prompt, const string &title, const GymEngine &engine, const SearchIndex &index)
+    {
+        string query = trim(ConsoleUI::getInput(prompt));
+        if (query.empty())
+            return -1;
+        if (isNumber(query))
+            return stoi(query);
+
+        vector<SearchHit> hits;
+        vector<string> options;
+        {
+            GymEngine::ReadGuard guard = engine.readLock();
+            hits = index.search(query);
+            if (hits.size() == 1)
+                return hits[0].id;
+
+            for (const SearchHit &hit : hits)
+                options.push_back("#" + to_string(hit.id) + "  " + index.nameOf(hit.id) + "  <" + index.emailOf(hit.id) + ">");
+        }
+        if (hits.empty())
+            return -1;
+        options.push_back("Cancel");
+
+        int choice = ConsoleUI::getMenuSelection(title + ": \"" + query + "\"", options);
+        if (choice < 0 || choice >= (int)hits.size())
+            return -1;
+        return hits[choice].id;
+    }
+};
+
+#endif
@@ -0,0 +1,670 @@
+#ifndef SERVER_SERVICE_H
+#define SERVER_SERVICE_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "../core/GymEngine.h"
+#include "../core/SessionManager.h"
+#include "../net/Socket.h"
+#include "../services/BatchService.h"
+#include "../services/LoadGenerator.h"
+#include "../services/PersistenceService.h"
+
+using namespace std;
+
+// Totals of one server run
+struct ServerStats
+{
+    size_t connections = 0; // Accepted
+    size_t requests = 0;    // Answered
+    size_t failed = 0;      // Answered with ERR
+};
+
+// ServerService - serves many reception desks from one engine (Linux, epoll)
+//
+// Protocol: one request per line, in the batch command language (see
+// BatchService) plus the session commands below; one reply line per request,
+// "<n> OK [result]" or "<n> ERR <message>", where n counts the connection's
+// requests. Clients may pipeline: replies come back in request order.
+//
+//   login <email> <password>   start an admin session, replies "OK <token> <name>"
+//   resume <token>             use a session opened earlier (e.g. before a reconnect)
+//   logout                     end the session (on every connection using it)
+//   ping                       check the connection (no login needed)
+//   quit                       reply, then close the connection
+//
+// Every other command needs a live session (see SessionManager): its token is
+// checked on each request, so a logout or an idle timeout applies at once.
+// Closing a connection keeps its session for 'resume'. One thread runs the event
+// loop; all mutations of one loop round share one log fsync, and no reply
+// leaves before the records it reports on are on disk. Password checks (a
+// slow hash on purpose) run on a few worker threads instead, and the
+// connection's later requests wait for its login reply.
+class ServerService
+{
+private:
+    static const size_t READ_CHUNK = 64 * 1024;
+    static const size_t MAX_REQUEST_BYTES = 4096;
+    static const size_t MAX_PENDING_REPLY_BYTES = 1 << 20; // Stop reading a client that does not read
+    static const int MAX_EVENTS = 256;
+    static const unsigned MAX_LOGIN_THREADS = 4;
+
+    // A login handed to the workers, and its result
+    struct LoginJob
+    {
+        int fd;              // Connection that asked
+        uint64_t connection; // Its Session::id (the descriptor may be reused by then)
+        size_t request;      // Request number to reply with
+        string email;
+        string password;
+        EngineResult<string> login{EngineStatus::InvalidCredentials, ""};
+        AdminSession admin;
+    };
+
+    // LoginWorkers - checks passwords off the event loop
+    // Finished jobs are queued and 'notifyFd' (an eventfd) is written, which
+    // wakes the loop up to send the replies.
+    class LoginWorkers
+    {
+    private:
+        SessionManager &sessionManager;
+        int notifyFd = -1;
+        mutex lock;
+        condition_variable hasWork;
+        deque<LoginJob> waiting, done;
+        vector<thread> threads;
+        bool stopping = false;
+
+        void work()
+        {
+            while (true)
+            {
+                LoginJob job;
+                {
+                    unique_lock<mutex> guard(lock);
+                    hasWork.wait(guard, [this] { return stopping || !waiting.empty(); });
+                    if (stopping)
+                        return;
+                    job = std::move(waiting.front());
+                    waiting.pop_front();
+                }
+
+                job.login = sessionManager.login(job.email, job.password, &job.admin);
+                job.password.clear();
+                {
+                    lock_guard<mutex> guard(lock);
+                    done.push_back(std::move(job));
+                }
+                uint64_t one = 1;
+                ssize_t ignored = write(notifyFd, &one, sizeof(one));
+                (void)ignored;
+            }
+        }
+
+    public:
+        explicit LoginWorkers(SessionManager &sessions) : sessionManager(sessions) {}
+        ~LoginWorkers() { stop(); }
+
+        void start(int eventFd)
+        {
+            stop();
+            notifyFd = eventFd;
+            stopping = false;
+            unsigned count = min(MAX_LOGIN_THREADS, max(1u, thread::hardware_concurrency()));
+            for (unsigned i = 0; i < count; i++)
+                threads.emplace_back(&LoginWorkers::work, this);
+        }
+
+        // Let the running checks finish, drop the rest
+        void stop()
+        {
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+            }
+            hasWork.notify_all();
+            for (thread &worker : threads)
+                worker.join();
+            threads.clear();
+            waiting.clear();
+            done.clear();
+        }
+
+        void submit(LoginJob &&job)
+        {
+            {
+                lock_guard<mutex> guard(lock);
+                waiting.push_back(std::move(job));
+            }
+            hasWork.notify_one();
+        }
+
+        // Move the finished jobs to 'finished'
+        void takeDone(vector<LoginJob> &finished)
+        {
+            lock_guard<mutex> guard(lock);
+            for (LoginJob &job : done)
+                finished.push_back(std::move(job));
+            done.clear();
+        }
+    };
+
+    // One client connection and its admin session
+    struct Session
+    {
+        uint64_t id = 0;        // Unique for the server's lifetime
+        Socket socket;
+        string input;           // Bytes of an incomplete request
+        string output;          // Replies not sent yet
+        size_t sent = 0;        // Bytes of 'output' already sent
+        size_t roundStart = 0;  // Where this round's replies start in 'output'
+        size_t requests = 0;
+        string token;           // Session token (empty = not logged in)
+        uint32_t events = 0;    // What epoll watches
+        bool touched = false;   // In this round's flush list
+        bool closing = false;   // Close once the replies are sent
+        bool loggingIn = false; // A login is with the workers; later requests wait
+    };
+
+    SessionManager &sessionManager;
+    BatchService &commands;
+    PersistenceService *persistence; // nullptr = no log to commit
+
+    SocketAddress address;
+    Socket listener;
+    Socket epoll;
+    Socket wakeUp; // eventfd written by stop() and by the login workers
+    LoginWorkers logins{sessionManager};
+    unordered_map<int, unique_ptr<Session>> sessions;
+    uint64_t lastSessionId = 0;
+    vector<Session *> touched;
+    atomic<bool> stopping{false};
+    string failure; // Why serve() stopped on its own (empty = it did not)
+    ServerStats stats;
+
+    bool watch(int fd, uint32_t events, int operation)
+    {
+        epoll_event event;
+        event.events = events;
+        event.data.fd = fd;
+        return epoll_ctl(epoll.get(), operation, fd, &event) == 0;
+    }
+
+    void touch(Session &session)
+    {
+        if (!session.touched)
+        {
+            session.touched = true;
+            session.roundStart = session.output.size();
+            touched.push_back(&session);
+        }
+    }
+
+    void acceptAll()
+    {
+        while (true)
+        {
+            Socket client = listener.acceptOne();
+            if (!client.isOpen())
+                return; // EAGAIN (or a client that vanished)
+
+            if (!address.local)
+                client.setNoDelay();
+
+            int fd = client.get();
+            unique_ptr<Session> session(new Session());
+            session->id = ++lastSessionId;
+            session->socket = std::move(client);
+            session->events = EPOLLIN | EPOLLRDHUP;
+            if (!watch(fd, session->events, EPOLL_CTL_ADD))
+                continue;
+
+            sessions[fd] = std::move(session);
+            stats.connections++;
+        }
+    }
+
+    // ---------- Requests ----------
+
+    void reply(Session &session, bool ok)
+    {
+        session.output += '\n';
+        stats.requests++;
+        if (!ok)
+            stats.failed++;
+    }
+
+    void fail(Session &session, string_view message)
+    {
+        session.output += " ERR ";
+        session.output += message;
+        reply(session, false);
+    }
+
+    void handleRequest(Session &session, string_view line)
+    {
+        array<string_view, BatchService::MAX_FIELDS> fields;
+        size_t count = BatchService::splitFields(line, fields);
+        if (count == 0)
+            return; // Blank line / comment: no reply
+
+        session.requests++;
+        string_view name = fields[0];
+        if (name == "login" && count == 3)
+        {
+            // Replied to in finishLogins(), once a worker has checked the password
+            session.loggingIn = true;
+            LoginJob job;
+            job.fd = session.socket.get();
+            job.connection = session.id;
+            job.request = session.requests;
+            job.email = string(fields[1]);
+            job.password = string(fields[2]);
+            logins.submit(std::move(job));
+            return;
+        }
+
+        session.output += to_string(session.requests);
+        if (name == "ping")
+        {
+            session.output += " OK pong";
+            reply(session, true);
+        }
+        else if (name == "quit")
+        {
+            session.output += " OK";
+            reply(session, true);
+            session.closing = true;
+        }
+        else if (name == "login")
+        {
+            fail(session, "Usage: login <email> <password>");
+        }
+        else if (name == "resume")
+        {
+            AdminSession admin;
+            if (count != 2)
+                return fail(session, "Usage: resume <token>");
+            if (!sessionManager.validate(fields[1], &admin))
+                return fail(session, "Unknown or expired session");
+            session.token = string(fields[1]);
+            session.output += " OK ";
+            session.output += admin.name;
+            reply(session, true);
+        }
+        else if (name == "logout")
+        {
+            sessionManager.logout(session.token);
+            session.token.clear();
+            session.output += " OK";
+            reply(session, true);
+        }
+        else if (session.token.empty() || !sessionManager.validate(session.token))
+        {
+            session.token.clear();
+            fail(session, "Not logged in");
+        }
+        else
+        {
+            BatchCommand command;
+            BatchService::parseLine(line, session.requests, command);
+            reply(session, commands.runCommand(command, session.output));
+        }
+    }
+
+    // Answer every complete request received so far (up to a login, whose
+    // reply the rest waits for)
+    void handleInput(Session &session)
+    {
+        size_t start = 0;
+        size_t end;
+        while (!session.closing && !session.loggingIn && (end = session.input.find('\n', start)) != string::npos)
+        {
+            handleRequest(session, string_view(session.input).substr(start, end - start));
+            start = end + 1;
+        }
+        session.input.erase(0, start);
+
+        if (!session.loggingIn && session.input.size() > MAX_REQUEST_BYTES)
+        {
+            session.requests++;
+            session.output += to_string(session.requests);
+            fail(session, "Request too long");
+            session.closing = true;
+        }
+    }
+
+    // Read what the client sent and answer every complete request
+    void readFrom(Session &session)
+    {
+        char buffer[READ_CHUNK];
+        ssize_t received = recv(session.socket.get(), buffer, sizeof(buffer), 0);
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            return;
+        touch(session);
+        if (received <= 0)
+        {
+            session.closing = true; // Peer closed (or reset): send what is left, then close
+            return;
+        }
+
+        session.input.append(buffer, (size_t)received);
+        handleInput(session);
+    }
+
+    // Reply to the logins the workers have checked, then go on with the
+    // requests that waited for them
+    void finishLogins()
+    {
+        uint64_t count;
+        ssize_t ignored = read(wakeUp.get(), &count, sizeof(count)); // Reset the eventfd
+        (void)ignored;
+
+        vector<LoginJob> finished;
+        logins.takeDone(finished);
+        for (LoginJob &job : finished)
+        {
+            auto it = sessions.find(job.fd);
+            if (it == sessions.end() || it->second->id != job.connection)
+                continue; // The connection is gone
+            Session &session = *it->second;
+
+            touch(session);
+            session.loggingIn = false;
+            session.output += to_string(job.request);
+            if (!job.login.ok())
+                fail(session, engineStatusMessage(job.login.status));
+            else
+            {
+                session.token = std::move(job.login.value);
+                session.output += " OK ";
+                session.output += session.token;
+                session.output += ' ';
+                session.output += job.admin.name;
+                reply(session, true);
+            }
+            handleInput(session);
+        }
+    }
+
+    // ---------- Replies ----------
+
+    void closeSession(Session &session)
+    {
+        epoll_ctl(epoll.get(), EPOLL_CTL_DEL, session.socket.get(), nullptr);
+        sessions.erase(session.socket.get()); // Frees 'session'
+    }
+
+    // Send pending replies; returns false if the session was closed
+    bool flush(Session &session)
+    {
+        while (session.sent < session.output.size())
+        {
+            ssize_t written = send(session.socket.get(), session.output.data() + session.sent,
+                                   session.output.size() - session.sent, MSG_NOSIGNAL);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+                closeSession(session); // Broken pipe / reset
+                return false;
+            }
+            session.sent += (size_t)written;
+        }
+
+        size_t pending = session.output.size() - session.sent;
+        if (pending == 0)
+        {
+            session.output.clear();
+            session.sent = 0;
+            if (session.closing)
+            {
+                closeSession(session);
+                return false;
+            }
+        }
+
+        // Watch for writability while replies are queued; stop reading while too many are
+        uint32_t events = EPOLLRDHUP;
+        if (pending > 0)
+            events |= EPOLLOUT;
+        if (pending < MAX_PENDING_REPLY_BYTES && !session.closing && !session.loggingIn)
+            events |= EPOLLIN;
+        if (events != session.events)
+        {
+            session.events = events;
+            watch(session.socket.get(), events, EPOLL_CTL_MOD);
+        }
+        return true;
+    }
+
+    // Turn every reply of this round into an ERR (its changes were not logged)
+    void failRound(Session &session, string_view message)
+    {
+        string replies = session.output.substr(session.roundStart);
+        session.output.resize(session.roundStart);
+        size_t start = 0;
+        size_t end;
+        while ((end = replies.find('\n', start)) != string::npos)
+        {
+            string_view line = string_view(replies).substr(start, end - start);
+            size_t space = min(line.find(' '), line.size()); // After the request number
+            if (line.compare(space, 5, " ERR ") != 0)
+                stats.failed++;
+            session.output.append(line.substr(0, space));
+            session.output += " ERR ";
+            session.output += message;
+            session.output += '\n';
+            start = end + 1;
+        }
+    }
+
+    // Make this round's mutations durable, then send the replies that report them.
+    // If the log cannot be written, the round's records are dropped, every reply
+    // of the round becomes an ERR and the server stops.
+    void flushTouched()
+    {
+        if (touched.empty())
+            return;
+        if (persistence != nullptr && !persistence->commitLog())
+        {
+            persistence->discardLog();
+            failure = "Cannot write " + persistence->getLogPath() + "; the server stopped";
+            for (Session *session : touched)
+                failRound(*session, "Cannot write the journal; the server is stopping");
+            stopping = true;
+        }
+
+        for (Session *session : touched)
+        {
+            session->touched = false;
+            flush(*session);
+        }
+        touched.clear();
+    }
+
+public:
+    ServerService(SessionManager &sessions, BatchService &batchService, PersistenceService *persistenceService = nullptr)
+        : sessionManager(sessions), commands(batchService), persistence(persistenceService) {}
+
+    ServerService(const ServerService &) = delete;
+    ServerService &operator=(const ServerService &) = delete;
+
+    // Listen on 'text' (see SocketAddress); false + error on failure
+    bool start(const string &text, string &error)
+    {
+        if (!SocketAddress::parse(text, address, error) || !listener.listenOn(address, error))
+            return false;
+
+        epoll = Socket(epoll_create1(EPOLL_CLOEXEC));
+        wakeUp = Socket(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+        if (!epoll.isOpen() || !wakeUp.isOpen() || !watch(listener.get(), EPOLLIN, EPOLL_CTL_ADD) ||
+            !watch(wakeUp.get(), EPOLLIN, EPOLL_CTL_ADD))
+        {
+            error = string("Cannot set up the event loop: ") + strerror(errno);
+            return false;
+        }
+        stopping = false;
+        failure.clear();
+        logins.start(wakeUp.get());
+        return true;
+    }
+
+    // Address actually listened on (a TCP port 0 is resolved)
+    string boundAddress() const { return address.toString(); }
+
+    // Ask serve() to return (safe from other threads and signal handlers)
+    void stop()
+    {
+        stopping = true;
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeUp.get(), &one, sizeof(one));
+        (void)ignored;
+    }
+
+    // Run the event loop until stop(); false + error if it broke down
+    bool serve(string &error)
+    {
+        if (persistence != nullptr)
+            persistence->setGroupCommit(SIZE_MAX, 0); // Committed once per round below
+
+        epoll_event events[MAX_EVENTS];
+        bool ok = true;
+        while (!stopping)
+        {
+            int ready = epoll_wait(epoll.get(), events, MAX_EVENTS, -1);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                error = string("Event loop failed: ") + strerror(errno);
+                ok = false;
+                break;
+            }
+
+            for (int i = 0; i < ready; i++)
+            {
+                int fd = events[i].data.fd;
+                if (fd == listener.get())
+                {
+                    acceptAll();
+                    continue;
+                }
+                if (fd == wakeUp.get())
+                {
+                    finishLogins(); // Or stop() was called: 'stopping' is set
+                    continue;
+                }
+
+                auto it = sessions.find(fd);
+                if (it == sessions.end())
+                    continue;
+                Session &session = *it->second;
+
+                if (session.closing)
+                    touch(session); // Only the remaining replies matter now
+                else if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                    readFrom(session);
+                if (events[i].events & EPOLLOUT)
+                    touch(session);
+            }
+            flushTouched();
+        }
+
+        // Deliver what is already answered, then drop every connection and
+        // stop listening (a Unix socket file is removed)
+        flushTouched();
+        logins.stop();
+        sessions.clear();
+        listener.close();
+        if (persistence != nullptr)
+        {
+            if (!persistence->commitLog())
+            {
+                persistence->discardLog();
+                failure = "Cannot write " + persistence->getLogPath();
+            }
+            persistence->setGroupCommit(1, 0);
+        }
+        if (ok && !failure.empty())
+        {
+            error = failure;
+            ok = false;
+        }
+        return ok;
+    }
+
+    const ServerStats &getStats() const { return stats; }
+
+    // Serve a fresh engine in a background thread and load it with the load
+    // generator over a Unix socket and over TCP loopback. Prints requests / s
+    // and latency percentiles to 'out'; false if a run failed.
+    static bool benchmark(size_t connections, size_t requests, ostream &out)
+    {
+        static const char *SOCKET_PATH = "elforma-bench.sock";
+        static const char *SNAPSHOT_PATH = "elforma-bench.snapshot";
+
+        bool ok = true;
+        for (const char *where : {"unix:elforma-bench.sock", "127.0.0.1:0"})
+        {
+            GymEngine benchEngine;
+            PersistenceService benchPersistence(benchEngine, SNAPSHOT_PATH);
+            BatchService benchCommands(benchEngine, &benchPersistence);
+            SessionManager benchSessions(benchEngine);
+            ServerService server(benchSessions, benchCommands, &benchPersistence);
+
+            string error;
+            if (!benchPersistence.load(error) || !server.start(where, error))
+            {
+                out << "Cannot start the server: " << error << endl;
+                return false;
+            }
+
+            string serverError;
+            bool served = true;
+            thread loop([&server, &serverError, &served] { served = server.serve(serverError); });
+
+            LoadOptions options;
+            options.address = server.boundAddress();
+            options.connections = connections;
+            options.requests = requests;
+
+            LoadReport report;
+            bool loaded = LoadGenerator::run(options, report, error);
+            server.stop();
+            loop.join();
+
+            if (!loaded || !served)
+            {
+                out << (loaded ? serverError : error) << endl;
+                ok = false;
+            }
+            else
+                LoadGenerator::print(report, options, out);
+
+            remove(SNAPSHOT_PATH);
+            remove((string(SNAPSHOT_PATH) + ".wal").c_str());
+        }
+        remove(SOCKET_PATH);
+        return ok;
+    }
+};
+
+#endif
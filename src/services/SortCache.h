@@ -0,0 +1,129 @@
+#ifndef SORT_CACHE_H
+#define SORT_CACHE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "../storage/SlotMap.h"
+
+using namespace std;
+
+// SortCache<T> - listing orders of a SlotMap<T>, one per sortable column
+// An order is a vector of handles, sorted the first time its column is asked
+// for (ties go by ID) and then kept. When the engine's revision has moved on,
+// the order is repaired instead of sorted again: the handles of deleted and
+// changed entities are dropped in one pass, and the changed / new entities
+// (revision newer than the order, see GymEngine::touch) are sorted on their
+// own and merged in - O(n + k log k) for k changes instead of O(n log n).
+// When nothing changed the cached order is returned as it is.
+// Use it under the engine's read lock, from one thread.
+template <typename T>
+class SortCache
+{
+public:
+    using Compare = int (*)(const T &, const T &); // Negative, zero or positive, like strcmp
+
+private:
+    struct Order
+    {
+        vector<Handle<T>> handles;
+        uint64_t revision = 0; // Engine revision the order matches
+        bool built = false;
+    };
+
+    vector<Compare> columns;
+    vector<Order> orders;
+    vector<Handle<T>> changed; // Scratch space of repair() (reused)
+
+    // Repair 'order' from the entities changed after it was built
+    void repair(Order &order, const SlotMap<T> &values, Compare compare)
+    {
+        auto before = [&](Handle<T> a, Handle<T> b)
+        {
+            const T &x = *values.get(a);
+            const T &y = *values.get(b);
+            int result = compare(x, y);
+            return result != 0 ? result < 0 : x.getId() < y.getId();
+        };
+
+        if (!order.built)
+        {
+            order.handles.clear();
+            order.handles.reserve(values.size());
+            for (size_t i = 0; i < values.size(); i++)
+                order.handles.push_back(values.handleAt(i));
+            sort(order.handles.begin(), order.handles.end(), before);
+            return;
+        }
+
+        uint64_t since = order.revision;
+        changed.clear();
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            if (values.begin()[i].getRevision() > since)
+                changed.push_back(values.handleAt(i));
+        }
+
+        // Deleted entities left stale handles; changed ones come back with 'changed'
+        order.handles.erase(remove_if(order.handles.begin(), order.handles.end(), [&](Handle<T> handle)
+                                      {
+                                          const T *value = values.get(handle);
+                                          return value == nullptr || value->getRevision() > since;
+                                      }),
+                            order.handles.end());
+
+        sort(changed.begin(), changed.end(), before);
+        size_t kept = order.handles.size();
+        order.handles.insert(order.handles.end(), changed.begin(), changed.end());
+        inplace_merge(order.handles.begin(), order.handles.begin() + kept, order.handles.end(), before);
+    }
+
+public:
+    // One comparison per column (the column index is the table column)
+    explicit SortCache(vector<Compare> columnCompares)
+        : columns(std::move(columnCompares)), orders(columns.size()) {}
+
+    size_t columnCount() const { return columns.size(); }
+
+    // 'values' in the order of 'column'; 'revision' is GymEngine::revision()
+    const vector<Handle<T>> &sorted(const SlotMap<T> &values, size_t column, uint64_t revision)
+    {
+        Order &order = orders[column];
+        if (!order.built || order.revision != revision)
+        {
+            repair(order, values, columns[column]);
+            order.revision = revision;
+            order.built = true;
+        }
+        return order.handles;
+    }
+
+    // --- Comparison helpers for the column functions ---
+
+    template <typename N>
+    static int compareNumbers(N a, N b)
+    {
+        return (a > b) - (a < b);
+    }
+
+    // Case-insensitive (ASCII), so "ahmed" sorts next to "Ahmed"
+    static int compareText(string_view a, string_view b)
+    {
+        size_t length = min(a.size(), b.size());
+        for (size_t i = 0; i < length; i++)
+        {
+            unsigned char x = (unsigned char)a[i], y = (unsigned char)b[i];
+            if (x >= 'A' && x <= 'Z')
+                x += 'a' - 'A';
+            if (y >= 'A' && y <= 'Z')
+                y += 'a' - 'A';
+            if (x != y)
+                return x < y ? -1 : 1;
+        }
+        return compareNumbers(a.size(), b.size());
+    }
+};
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef TABLE_VIEW_H
+#define TABLE_VIEW_H
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ConsoleUI.h"
+#include "ScreenBuffer.h"
+
+using namespace std;
+
+// The formatted cells of one row, back to back (kept by RowCache, see RowCache.h)
+struct TableRow
+{
+    string cells;
+    vector<uint32_t> ends; // Where each cell ends in 'cells'
+
+    void add(string_view text)
+    {
+        cells.append(text);
+        ends.push_back((uint32_t)cells.size());
+    }
+};
+
+// TableView - a listing shown one terminal-sized page at a time
+// The cells of a page are copied back to back into one reused string, so a
+// page costs no allocation per cell. Column widths are measured over that page
+// only (never the whole listing) and narrowed to fit the terminal; cells that
+// do not fit are cut and end with '~'. The page is formatted into one string
+// and sent to the terminal in a single write.
+class TableView
+{
+private:
+    static const int RESERVED_LINES = 8;   // Title, summary, column header, rule and footer
+    static const int MIN_COLUMN_WIDTH = 4; // Columns are never narrowed below this
+
+    vector<string> headers;
+    string cells;           // The cells of every row of the page, back to back
+    vector<uint32_t> ends;  // Where each cell ends in 'cells' (row by row)
+    vector<int> widths;     // Column widths of the page
+    string out;             // The formatted page (reused)
+    int sortColumn = -1;    // Header marked with the sort direction (-1 = none)
+    bool sortDescending = false;
+
+    // Characters (UTF-8 code points) in a cell
+    static int displayWidth(string_view text)
+    {
+        int width = 0;
+        for (char c : text)
+            if (((unsigned char)c & 0xC0) != 0x80) // Not a continuation byte
+                width++;
+        return width;
+    }
+
+    // Header text, with the sort direction on the sorted column
+    string header(size_t column) const
+    {
+        if ((int)column != sortColumn)
+            return headers[column];
+        return headers[column] + (sortDescending ? " v" : " ^");
+    }
+
+    string_view cell(size_t row, size_t column) const
+    {
+        size_t index = row * headers.size() + column;
+        size_t start = index == 0 ? 0 : ends[index - 1];
+        return string_view(cells).substr(start, ends[index] - start);
+    }
+
+    // Widest cell of each column, then the widest columns give way until the
+    // table (one space between columns) fits in 'maxWidth'
+    void fitWidths(int maxWidth)
+    {
+        widths.assign(headers.size(), 0);
+        for (size_t column = 0; column < headers.size(); column++)
+            widths[column] = displayWidth(header(column));
+        for (size_t row = 0; row < rowCount(); row++)
+            for (size_t column = 0; column < headers.size(); column++)
+                widths[column] = max(widths[column], displayWidth(cell(row, column)));
+
+        int total = (int)headers.size() - 1;
+        for (int width : widths)
+            total += width;
+        while (total > maxWidth)
+        {
+            auto widest = max_element(widths.begin(), widths.end());
+            if (*widest <= MIN_COLUMN_WIDTH)
+                break; // Too narrow a terminal: let the lines wrap
+            (*widest)--;
+            total--;
+        }
+    }
+
+    // One cell padded to its column (no padding after the last column)
+    void appendCell(string_view text, size_t column)
+    {
+        int width = widths[column];
+        int length = displayWidth(text);
+        if (length > width)
+        {
+            // Keep width - 1 characters (whole UTF-8 sequences) and mark the cut
+            size_t end = 0;
+            int kept = 0;
+            for (; end < text.size(); end++)
+            {
+                if (((unsigned char)text[end] & 0xC0) != 0x80 && kept++ == width - 1)
+                    break;
+            }
+            out.append(text.substr(0, end));
+            out += '~';
+        }
+        else
+        {
+            out.append(text);
+            if (column + 1 < headers.size())
+                out.append((size_t)(width - length), ' ');
+        }
+        out += column + 1 < headers.size() ? ' ' : '\n';
+    }
+
+    // Format the whole page and send it in one write
+    void print(const string &title, const string &summary)
+    {
+        int height, width;
+        ScreenBuffer::terminalSize(height, width);
+        fitWidths(width);
+
+        out = "\033[0m\033[H\033[2J"; // Same as ConsoleUI::clear()
+        out += "=== " + title + " ===\n";
+        out += "\n[INFO] " + summary + "\n\n";
+        for (size_t column = 0; column < headers.size(); column++)
+            appendCell(header(column), column);
+
+        int tableWidth = (int)headers.size() - 1;
+        for (int columnWidth : widths)
+            tableWidth += columnWidth;
+        out.append((size_t)min(tableWidth, width), '-');
+        out += '\n';
+
+        for (size_t row = 0; row < rowCount(); row++)
+            for (size_t column = 0; column < headers.size(); column++)
+                appendCell(cell(row, column), column);
+
+        ConsoleUI::screen().invalidate(); // The screen was cleared behind its back
+        ScreenBuffer::writeOut(out);
+    }
+
+public:
+    explicit TableView(vector<string> columnHeaders) : headers(std::move(columnHeaders)) {}
+
+    // Rows of a page that fit the terminal
+    static size_t pageRows()
+    {
+        int height, width;
+        ScreenBuffer::terminalSize(height, width);
+        return (size_t)max(1, height - RESERVED_LINES);
+    }
+
+    // Mark a column as the one the rows are sorted by
+    void setSortColumn(size_t column, bool descending)
+    {
+        sortColumn = (int)column;
+        sortDescending = descending;
+    }
+
+    // Start an empty page
+    void clear()
+    {
+        cells.clear();
+        ends.clear();
+    }
+
+    // Add a row (one cell per header; the text is copied)
+    void addRow(initializer_list<string_view> row)
+    {
+        for (string_view text : row)
+        {
+            cells.append(text);
+            ends.push_back((uint32_t)cells.size());
+        }
+    }
+
+    // Add a formatted row: its first 'count' cells, copied in one go, then 'more'
+    void addRow(const TableRow &row, size_t count, initializer_list<string_view> more = {})
+    {
+        uint32_t base = (uint32_t)cells.size();
+        cells.append(row.cells, 0, count == 0 ? 0 : row.ends[count - 1]);
+        for (size_t i = 0; i < count; i++)
+            ends.push_back(base + row.ends[i]);
+        addRow(more);
+    }
+
+    void addRow(const TableRow &row) { addRow(row, row.ends.size()); }
+
+    size_t rowCount() const { return headers.empty() ? 0 : ends.size() / headers.size(); }
+
+    // Page through a listing until the user goes back.
+    // 'fill(first, count)' adds rows [first, first + count) of the listing and
+    // returns how many rows the listing has. It is called once per page, so it
+    // can take the engine's read lock just for that page; the listing may
+    // change between pages. 'noun' names the rows ("members").
+    template <typename Fill>
+    void browse(const string &title, string_view noun, string_view emptyMessage, Fill fill)
+    {
+        browse(title, noun, emptyMessage, fill, "", "", [](char) {});
+    }
+
+    // Same, with keys of its own: a letter in 'commandKeys' is passed to
+    // 'command(letter)' and the listing is shown again from its first page.
+    // 'commandHint' tells the user about them.
+    template <typename Fill, typename Command>
+    void browse(const string &title, string_view noun, string_view emptyMessage, Fill fill,
+                string_view commandKeys, string_view commandHint, Command command)
+    {
+        size_t page = 0;
+        while (true)
+        {
+            size_t pageSize = pageRows(); // Again every page: the terminal may be resized
+            clear();
+            size_t total = fill(page * pageSize, pageSize);
+            if (total == 0)
+            {
+                ConsoleUI::printHeader(title);
+                ConsoleUI::printWarning(emptyMessage);
+                ConsoleUI::pause();
+                return;
+            }
+
+            size_t pageCount = (total + pageSize - 1) / pageSize;
+            if (page >= pageCount)
+            {
+                page = pageCount - 1; // The listing shrank: show its last page
+                continue;
+            }
+
+            size_t first = page * pageSize;
+            string summary = to_string(first + 1) + "-" + to_string(first + rowCount()) + " of " +
+                             to_string(total) + " " + string(noun);
+            if (!commandHint.empty())
+                summary += "   " + string(commandHint);
+            print(title, summary);
+
+            char key = 0;
+            int next = ConsoleUI::getPageNavigation((int)page, (int)pageCount, commandKeys, &key);
+            if (key != 0)
+            {
+                command(key);
+                page = 0;
+                continue;
+            }
+            if (next < 0)
+                return;
+            page = (size_t)next;
+        }
+    }
+};
+
+#endif
@@ -5,46 +5,75 @@
 #include <vector>
 #include <string>
 
+#include "../core/GymEngine.h"
 #include "../entities/Trainer.h"
 #include "../entities/Member.h"
 #include "../services/ConsoleUI.h"
+#include "../services/SearchPrompt.h"
+#include "../services/RowCache.h"
+#include "../services/SortCache.h"
+#include "../services/TableView.h"
 
 using namespace std;
 
-// TrainerService class - handles trainer operations with UI
+// TrainerService class - console front-end for trainer operations
+// All data and rules live in GymEngine; this class only asks and prints.
+// The engine's read lock is held only while a screen is drawn.
 class TrainerService {
 private:
-    // Vector to store trainers in memory (shared across all instances)
-    static vector<Trainer*> trainers;
-    static bool initialized;
-    
-    // Initialize with fake trainers for testing
-    void initialize() {
-        if (!initialized) {
-            // Create fake trainers
-            trainers.push_back(new Trainer("Amir", "amir@gmail.com", "trainer123", "Cardio"));
-            trainers.push_back(new Trainer("Kareem", "kareem@gmail.com", "trainer456", "Strength Training"));
-            trainers.push_back(new Trainer("Maged", "maged@gmail.com", "trainer789", "Yoga"));
-            
-            initialized = true;
-        }
+    GymEngine& engine;
+    RowCache trainerRows; // Listing rows: ID, name, email, specialty, assigned count
+    SortCache<Trainer> trainerOrders; // "View All Trainers" orders, one per column
+    size_t sortColumn = 0;            // Kept between visits to the screen
+    bool sortDescending = false;
+
+    // Report a failed engine operation
+    static void printFailure(EngineStatus status) {
+        ConsoleUI::printError(string(engineStatusMessage(status)) + "!");
+        if (status == EngineStatus::InvalidSpecialty)
+            ConsoleUI::printInfo("Allowed: " + string(SPECIALTY_ALIASES_HELP));
+        else if (status == EngineStatus::JournalFailed)
+            ConsoleUI::printInfo("Nothing was changed: the data files could not be written (disk full?)");
+        ConsoleUI::pause();
     }
 
-    // Add or Update Trainer Helper - Normalize and Validate Specialty type
-    string getNormalizedSpecialty(const string& inputSpecialty) {
-        string lowerSpec = ConsoleUI::toLower(inputSpecialty);
-        if (lowerSpec == "cardio" || lowerSpec == "c" || lowerSpec == "1") return "Cardio";
-        if (lowerSpec == "strength" || lowerSpec == "s" || lowerSpec == "strength training" || lowerSpec == "2") return "Strength Training";
-        if (lowerSpec == "yoga" || lowerSpec == "y" || lowerSpec == "3") return "Yoga";
-        
-        return "Unknown";
+    // Name of a trainer, copied out under the read lock (false if not found)
+    bool trainerName(int id, string& name) const {
+        GymEngine::ReadGuard guard = engine.readLock();
+        const Trainer* trainer = engine.findTrainer(id);
+        if (trainer == nullptr) return false;
+        name = trainer->getName();
+        return true;
+    }
+
+    // How "View All Trainers" sorts by each of its columns
+    static vector<SortCache<Trainer>::Compare> trainerSortColumns() {
+        using Sort = SortCache<Trainer>;
+        return {
+            [](const Trainer& a, const Trainer& b) { return Sort::compareNumbers(a.getId(), b.getId()); },
+            [](const Trainer& a, const Trainer& b) { return Sort::compareText(a.getName(), b.getName()); },
+            [](const Trainer& a, const Trainer& b) { return Sort::compareText(a.getEmail(), b.getEmail()); },
+            [](const Trainer& a, const Trainer& b)
+            { return Sort::compareText(a.getTrainerSpecialtyName(), b.getTrainerSpecialtyName()); },
+            [](const Trainer& a, const Trainer& b)
+            { return Sort::compareNumbers(a.getAssignedCount(), b.getAssignedCount()); }};
+    }
+
+    // Listing row of a trainer, formatted again only after it changed
+    // (an update or an assignment; hold the engine's read lock)
+    const TableRow& trainerRow(const Trainer& trainer) {
+        return trainerRows.get(trainer.getId(), trainer.getRevision(), [&](TableRow& row) {
+            row.add(to_string(trainer.getId()));
+            row.add(trainer.getName());
+            row.add(trainer.getEmail());
+            row.add(trainer.getTrainerSpecialtyName());
+            row.add(to_string(trainer.getAssignedCount()));
+        });
     }
 
 public:
     // Constructor
-    TrainerService() {
-        initialize();
-    }
+    TrainerService(GymEngine& gymEngine) : engine(gymEngine), trainerOrders(trainerSortColumns()) {}
 
     // Add new trainer with UI
     void addTrainer() {
@@ -54,96 +83,97 @@ public:
 
         if (data.empty()) return; // Cancelled
 
-        // Validation
-        string specInput = getNormalizedSpecialty(data[3]);
-        
-        if (specInput == "Unknown") {
-            ConsoleUI::printError("Invalid Specialty!");
-            ConsoleUI::printInfo("Allowed: Cardio, Strength, Yoga");
-            ConsoleUI::pause();
+        // Validation happens in the engine (specialty, unique email)
+        EngineResult<int> result = engine.addTrainer(data[0], data[1], data[2], parseSpecialty(data[3]));
+
+        if (!result.ok()) {
+            printFailure(result.status);
             return; // Cancel the operation, Stop creation
         }
-
-        Trainer* newTrainer = new Trainer(data[0], data[1], data[2], specInput);
-        trainers.push_back(newTrainer);
         
         ConsoleUI::printSuccess("Trainer added successfully!");
-        ConsoleUI::printInfo("Trainer ID: " + to_string(newTrainer->getId()));
+        ConsoleUI::printInfo("Trainer ID: " + to_string(result.value));
         ConsoleUI::pause();
     }
     
-    // View all trainers with UI
+    // View all trainers with UI, one page at a time, sorted by any column
     void viewAllTrainers() {
-        ConsoleUI::printHeader("All Trainers");
-        
-        if (trainers.empty()) {
-            ConsoleUI::printWarning("No trainers found!");
-            return;
-        }
-        
-        vector<string> headers = {"ID", "Name", "Email", "Specialty", "Assigned Members"};
-        vector<int> widths = {8, 20, 25, 20, 18};
-        
-        ConsoleUI::printTableHeader(headers, widths);
-        
-        for (const Trainer* trainer : trainers) {
-            vector<string> row = {
-                to_string(trainer->getId()),
-                trainer->getName(),
-                trainer->getEmail(),
-                trainer->getTrainerSpecialty(),
-                to_string(trainer->getAssignedMembers().size())
-            };
-            ConsoleUI::printTableRow(row, widths);
-        }
-        ConsoleUI::pause();
+        TableView table({"ID", "Name", "Email", "Specialty", "Assigned Members"});
+        table.setSortColumn(sortColumn, sortDescending);
+        table.browse("All Trainers", "trainers", "No trainers found!", [&](size_t first, size_t count) {
+            GymEngine::ReadGuard guard = engine.readLock();
+            const SlotMap<Trainer>& trainers = engine.getTrainers();
+            const vector<Handle<Trainer>>& order = trainerOrders.sorted(trainers, sortColumn, engine.revision());
+            size_t stop = min(order.size(), first + count);
+            for (size_t i = first; i < stop; i++)
+                table.addRow(trainerRow(*trainers.get(order[sortDescending ? order.size() - 1 - i : i])));
+
+            trainerRows.trim(trainers.size(), [&](int id) { return engine.findTrainer(id) != nullptr; });
+            return order.size();
+        },
+        "sr", "[S] Sort by next column  [R] Reverse", [&](char key) {
+            if (key == 's') {
+                sortColumn = (sortColumn + 1) % trainerOrders.columnCount();
+                sortDescending = false;
+            } else {
+                sortDescending = !sortDescending;
+            }
+            table.setSortColumn(sortColumn, sortDescending);
+        });
     }
     
     // View assigned members for a trainer with UI
     void viewAssignedMembers() {
         ConsoleUI::printHeader("Assigned Members");
         
-        if (trainers.empty()) {
+        if (engine.trainerCount() == 0) {
             ConsoleUI::printWarning("No trainers found!");
             return;
         }
         
-        int id = ConsoleUI::getIntInput("Enter trainer ID to view assigned members: ");
-        
-        Trainer* trainer = findTrainerById(id);
-        if (trainer == nullptr) {
+        int id = SearchPrompt::pickId("Enter trainer ID, name or email: ", "SELECT TRAINER", engine, engine.getTrainerSearch());
+
+        string name;
+        if (!trainerName(id, name)) {
             ConsoleUI::printError("Trainer not found!");
             return;
         }
         
-        vector<string> headers = {"ID", "Name", "Email", "Specialty"};
-        vector<int> widths = {8, 20, 25, 20};
-        
-        ConsoleUI::printTableHeader(headers, widths);
-        
-        for (const Member* member : trainer->getAssignedMembers()) {
-            vector<string> row = {
-                to_string(member->getId()),
-                member->getName(),
-                member->getEmail(),
-                trainer->getTrainerSpecialty()
-            };
-            ConsoleUI::printTableRow(row, widths);
-        }
-        ConsoleUI::pause();
+        TableView table({"ID", "Name", "Email", "Specialty"});
+        table.browse("Members of " + name, "members", "No members assigned!", [&](size_t first, size_t count) {
+            GymEngine::ReadGuard guard = engine.readLock();
+            const Trainer* trainer = engine.findTrainer(id);
+            if (trainer == nullptr) return (size_t)0; // Deleted since the last page
+
+            // Stale handles (deleted members) are still counted, but not shown
+            const auto& assigned = trainer->getAssignedMembers();
+            size_t stop = min(assigned.size(), first + count);
+            for (size_t i = first; i < stop; i++) {
+                const Member* member = engine.getMembers().get(assigned[i]);
+                if (member == nullptr) continue;
+
+                table.addRow({
+                    to_string(member->getId()),
+                    member->getName(),
+                    member->getEmail(),
+                    trainer->getTrainerSpecialtyName()
+                });
+            }
+            return assigned.size();
+        });
     }
     
     // Update trainer with UI
-    void updateTrainer(vector<Member*> availableMembers) {
-        if (trainers.empty()) {
+    void updateTrainer() {
+        if (engine.trainerCount() == 0) {
             ConsoleUI::printWarning("No trainers to update!");
             return;
         }
         
-        int id = ConsoleUI::getIntInput("Enter trainer ID to update: ");
+        int id = SearchPrompt::pickId("Enter trainer ID, name or email to update: ", "SELECT TRAINER", engine, engine.getTrainerSearch());
         
-        Trainer* trainer = findTrainerById(id);
-        if (trainer == nullptr) {
+        string trainerName;
+        if (!this->trainerName(id, trainerName)) {
             ConsoleUI::printError("Trainer not found!");
             return;
         }
@@ -155,7 +185,7 @@ public:
             "Cancel"
         };
         
-        int choice = ConsoleUI::getMenuSelection("UPDATE TRAINER: " + trainer->getName(), opts);
+        int choice = ConsoleUI::getMenuSelection("UPDATE TRAINER: " + trainerName, opts);
         
         // ---  Update Specialty ---
         if (choice == 0) { 
@@ -163,57 +193,46 @@ public:
                 string input = ConsoleUI::getInput("Enter new specialty (Cardio/Strength/Yoga): ");
                 
                 // Validation
-                string validSpec = getNormalizedSpecialty(input);
+                Specialty validSpec = parseSpecialty(input);
+                EngineStatus status = engine.changeSpecialty(id, validSpec);
                 
-                if (validSpec != "Unknown") {
-                    trainer->setTrainerSpecialty(validSpec);
-                    ConsoleUI::printSuccess("Specialty updated to " + validSpec + "!");
+                if (status == EngineStatus::Ok) {
+                    ConsoleUI::printSuccess("Specialty updated to " + string(specialtyName(validSpec)) + "!");
                     ConsoleUI::pause();
                     break; // Success! Exit loop.
-                } else {
-                    ConsoleUI::printError("Invalid input. Please try again.");
                 }
+                if (status != EngineStatus::InvalidSpecialty || ConsoleUI::inputClosed()) {
+                    printFailure(status); // Asking again would not help
+                    break;
+                }
+                ConsoleUI::printError("Invalid input. Please try again.");
             }
         } 
         // ---  Assign Member ---
         else if (choice == 1) { 
-            if (availableMembers.empty()) {
+            if (engine.memberCount() == 0) {
                 ConsoleUI::printWarning("No members available to assign!");
                 return;
             }
             
-            // Show Table
-            ConsoleUI::printHeader("Available Members");
-            vector<string> headers = {"ID", "Name", "Email"};
-            vector<int> widths = {8, 20, 25};
-            ConsoleUI::printTableHeader(headers, widths);
+            // Search instead of listing every member
+            ConsoleUI::printHeader("Assign Member to " + trainerName);
+            int memberId = SearchPrompt::pickId("Enter member ID, name or email to assign: ", "SELECT MEMBER", engine, engine.getMemberSearch());
             
-            for (const Member* member : availableMembers) {
-                vector<string> row = {
-                    to_string(member->getId()),
-                    member->getName(),
-                    member->getEmail()
-                };
-                ConsoleUI::printTableRow(row, widths);
-            }
-            
-            int memberId = ConsoleUI::getIntInput("Enter member ID to assign: ");
-            
-            Member* memberToAssign = nullptr;
-            for (Member* m : availableMembers) {
-                if (m->getId() == memberId) {
-                    memberToAssign = m;
-                    break;
-                }
-            }
-            
-            if (memberToAssign != nullptr) {
-                trainer->assignMember(memberToAssign);
-                ConsoleUI::pause();
+            EngineStatus status = engine.assignMember(id, memberId);
+            if (status == EngineStatus::Ok) {
+                GymEngine::ReadGuard guard = engine.readLock();
+                const Member* member = engine.findMember(memberId);
+                cout << ">> System: " << (member != nullptr ? member->getName() : "Member") << " assigned to " << trainerName << endl;
+            } else if (status == EngineStatus::AlreadyAssigned) {
+                ConsoleUI::printWarning("Member is already assigned to this trainer!");
+            } else if (status == EngineStatus::TrainerFull) {
+                cout << ">> Trainer can only Manage " << Trainer::MAX_ASSIGNED_MEMBERS << " Members at a time!" << endl;
             } else {
-                ConsoleUI::printError("Member not found!");
-                ConsoleUI::pause();
+                printFailure(status); // Member / trainer not found, or the change could not be logged
+                return;
             }
+            ConsoleUI::pause();
         } 
         // ---  Cancel ---
         else { 
@@ -225,55 +244,28 @@ public:
     void deleteTrainer() {
         ConsoleUI::printHeader("Delete Trainer");
         
-        if (trainers.empty()) {
+        if (engine.trainerCount() == 0) {
             ConsoleUI::printWarning("No trainers to delete!");
             return;
         }
         
-        int id = ConsoleUI::getIntInput("Enter trainer ID to delete: ");
+        int id = SearchPrompt::pickId("Enter trainer ID, name or email to delete: ", "SELECT TRAINER", engine, engine.getTrainerSearch());
         
-        for (auto it = trainers.begin(); it != trainers.end(); ++it) {
-            if ((*it)->getId() == id) {
-                string name = (*it)->getName();
-                delete *it;
-                trainers.erase(it);
-                ConsoleUI::printSuccess("Trainer '" + name + "' deleted successfully!");
-                ConsoleUI::pause();
-                return;
-            }
+        string name;
+        if (!trainerName(id, name)) {
+            ConsoleUI::printError("Trainer not found!");
+            ConsoleUI::pause();
+            return;
         }
-        
-        ConsoleUI::printError("Trainer not found!");
-        ConsoleUI::pause();
-    }
-    
-    // Find trainer by ID (internal use)
-    Trainer* findTrainerById(int id) {
-        for (Trainer* trainer : trainers) {
-            if (trainer->getId() == id) {
-                return trainer;
-            }
+        EngineStatus status = engine.deleteTrainer(id);
+        if (status != EngineStatus::Ok) {
+            printFailure(status);
+            return;
         }
-        return nullptr;
-    }
-    
-    // Check if trainers exist
-    bool isEmpty() {
-        return trainers.empty();
-    }
 
-    // Remove member from all trainers (called when a member is deleted)
-    static void removeMemberFromAllTrainers(int memberId)
-    {
-        for (Trainer *t : trainers)
-        {
-            t->removeMember(memberId);
-        }
+        ConsoleUI::printSuccess("Trainer '" + name + "' deleted successfully!");
+        ConsoleUI::pause();
     }
 };
 
-// Initialize static members
-vector<Trainer*> TrainerService::trainers;
-bool TrainerService::initialized = false;
-
 #endif // TRAINER_SERVICE_H
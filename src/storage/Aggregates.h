@@ -0,0 +1,114 @@
+#ifndef AGGREGATES_H
+#define AGGREGATES_H
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+
+#include "../entities/Date.h"
+#include "../entities/Subscription.h"
+#include "../entities/Trainer.h"
+
+using namespace std;
+
+// MemberAggregates - member counts kept up to date on every add / update / delete
+// Reading any figure is O(1); nothing ever scans the member table.
+class MemberAggregates
+{
+private:
+    size_t total = 0;
+    array<size_t, SUBSCRIPTION_TYPE_COUNT> byTier{};
+    unordered_map<int, size_t> joinsByMonth; // Date::monthKey -> members who joined then
+
+public:
+    void clear()
+    {
+        total = 0;
+        byTier.fill(0);
+        joinsByMonth.clear();
+    }
+
+    void add(SubscriptionType type, Date joinDate)
+    {
+        total++;
+        byTier[(size_t)type]++;
+        joinsByMonth[joinDate.monthKey()]++;
+    }
+
+    void remove(SubscriptionType type, Date joinDate)
+    {
+        total--;
+        byTier[(size_t)type]--;
+
+        auto it = joinsByMonth.find(joinDate.monthKey());
+        if (it != joinsByMonth.end() && --it->second == 0)
+            joinsByMonth.erase(it);
+    }
+
+    void changeTier(SubscriptionType from, SubscriptionType to)
+    {
+        byTier[(size_t)from]--;
+        byTier[(size_t)to]++;
+    }
+
+    size_t totalMembers() const { return total; }
+    size_t membersWith(SubscriptionType type) const { return byTier[(size_t)type]; }
+
+    // Members who joined in the month of 'date'
+    size_t joinsInMonthOf(Date date) const
+    {
+        auto it = joinsByMonth.find(date.monthKey());
+        return it != joinsByMonth.end() ? it->second : 0;
+    }
+};
+
+// TrainerLoadHistogram - how many trainers have 0, 1, ... MAX_ASSIGNED_MEMBERS members
+// Kept by GymEngine, updated whenever an assignment is added or removed.
+class TrainerLoadHistogram
+{
+public:
+    static const size_t BUCKETS = Trainer::MAX_ASSIGNED_MEMBERS + 1;
+
+private:
+    array<size_t, BUCKETS> trainersWithLoad{};
+    size_t trainers = 0;
+    size_t assignments = 0;
+
+public:
+    void clear()
+    {
+        trainersWithLoad.fill(0);
+        trainers = 0;
+        assignments = 0;
+    }
+
+    void addTrainer(size_t load)
+    {
+        trainers++;
+        assignments += load;
+        trainersWithLoad[load]++;
+    }
+
+    void removeTrainer(size_t load)
+    {
+        trainers--;
+        assignments -= load;
+        trainersWithLoad[load]--;
+    }
+
+    // A trainer went from 'from' to 'to' assigned members
+    void changeLoad(size_t from, size_t to)
+    {
+        trainersWithLoad[from]--;
+        trainersWithLoad[to]++;
+        assignments = assignments - from + to;
+    }
+
+    size_t totalTrainers() const { return trainers; }
+    size_t totalAssignments() const { return assignments; }
+    size_t trainersWith(size_t load) const { return load < BUCKETS ? trainersWithLoad[load] : 0; }
+
+    double averageLoad() const { return trainers == 0 ? 0.0 : (double)assignments / trainers; }
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Lookup table for the reflected polynomial 0xEDB88320 (built at compile time)
+constexpr array<uint32_t, 256> makeCrc32Table()
+{
+    array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        table[i] = c;
+    }
+    return table;
+}
+
+// Crc32 - standard CRC-32 (IEEE 802.3, same as zlib) for on-disk records
+class Crc32
+{
+private:
+    static constexpr array<uint32_t, 256> TABLE = makeCrc32Table();
+
+public:
+    // Continue a running checksum (start with crc = 0)
+    static uint32_t update(uint32_t crc, const void *data, size_t length)
+    {
+        const uint8_t *bytes = (const uint8_t *)data;
+        crc = ~crc;
+        for (size_t i = 0; i < length; i++)
+            crc = TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    static uint32_t compute(const void *data, size_t length) { return update(0, data, length); }
+};
+
+#endif
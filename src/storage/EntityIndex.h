@@ -0,0 +1,78 @@
+#ifndef ENTITY_INDEX_H
+#define ENTITY_INDEX_H
+
+#include <cctype>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// EntityIndex - hashed lookups by ID and by (lower-cased) email
+// Ref is whatever the owning service uses to reach the entity (pointer, handle...)
+// A default constructed Ref is returned when nothing matches.
+template <typename Ref>
+class EntityIndex
+{
+private:
+    unordered_map<int, Ref> byId;
+    unordered_map<string, int> idByEmail;
+
+public:
+    // Emails are case-insensitive ("Ahmed@Gmail.com" == "ahmed@gmail.com")
+    static string normalizeEmail(const string &email)
+    {
+        string key(email);
+        for (char &c : key)
+            c = (char)tolower((unsigned char)c);
+        return key;
+    }
+
+    void reserve(size_t count)
+    {
+        byId.reserve(count);
+        idByEmail.reserve(count);
+    }
+
+    // Register a new entity
+    void add(int id, const string &email, Ref ref)
+    {
+        byId[id] = ref;
+        idByEmail[normalizeEmail(email)] = id;
+    }
+
+    // Forget an entity
+    void remove(int id, const string &email)
+    {
+        byId.erase(id);
+
+        auto it = idByEmail.find(normalizeEmail(email));
+        if (it != idByEmail.end() && it->second == id)
+            idByEmail.erase(it);
+    }
+
+    void clear()
+    {
+        byId.clear();
+        idByEmail.clear();
+    }
+
+    // Lookups - O(1) on average
+    Ref findById(int id) const
+    {
+        auto it = byId.find(id);
+        return it != byId.end() ? it->second : Ref{};
+    }
+
+    Ref findByEmail(const string &email) const
+    {
+        auto it = idByEmail.find(normalizeEmail(email));
+        return it != idByEmail.end() ? findById(it->second) : Ref{};
+    }
+
+    bool containsId(int id) const { return byId.count(id) != 0; }
+    bool containsEmail(const string &email) const { return idByEmail.count(normalizeEmail(email)) != 0; }
+
+    size_t size() const { return byId.size(); }
+};
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef JOIN_DATE_INDEX_H
+#define JOIN_DATE_INDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../entities/Date.h"
+
+using namespace std;
+
+// One index entry: ordered by join date, then by member ID
+struct JoinDateEntry
+{
+    int32_t days; // Date::daysSinceEpoch
+    int32_t id;
+
+    bool operator<(const JoinDateEntry &other) const
+    {
+        return days != other.days ? days < other.days : id < other.id;
+    }
+};
+
+// JoinDateRange - the entries of a range query, oldest join date first
+// Only two pointers into the index: nothing is copied until it is iterated,
+// and page() just narrows the pointers. Invalidated by any change to the index.
+class JoinDateRange
+{
+private:
+    const JoinDateEntry *first;
+    const JoinDateEntry *last;
+
+public:
+    JoinDateRange(const JoinDateEntry *begin, const JoinDateEntry *end) : first(begin), last(end) {}
+
+    size_t size() const { return (size_t)(last - first); }
+    bool empty() const { return first == last; }
+
+    size_t pageCount(size_t pageSize) const
+    {
+        return pageSize == 0 ? 0 : (size() + pageSize - 1) / pageSize;
+    }
+
+    // Entries [page * pageSize, page * pageSize + pageSize) (empty past the end)
+    JoinDateRange page(size_t page, size_t pageSize) const
+    {
+        size_t start = min(size(), page * pageSize);
+        size_t stop = min(size(), start + pageSize);
+        return JoinDateRange(first + start, first + stop);
+    }
+
+    const JoinDateEntry *begin() const { return first; }
+    const JoinDateEntry *end() const { return last; }
+};
+
+// JoinDateIndex - member IDs kept sorted by join date for range queries
+// A sorted vector: add / remove shift the tail (one memmove) instead of
+// re-sorting, and new members usually join today so add() is mostly a push_back.
+class JoinDateIndex
+{
+private:
+    vector<JoinDateEntry> entries;
+
+public:
+    void reserve(size_t count) { entries.reserve(count); }
+    void clear() { entries.clear(); }
+    size_t size() const { return entries.size(); }
+
+    void add(int id, Date joinDate)
+    {
+        JoinDateEntry entry{joinDate.daysSinceEpoch(), id};
+        if (entries.empty() || entries.back() < entry)
+        {
+            entries.push_back(entry);
+            return;
+        }
+        entries.insert(lower_bound(entries.begin(), entries.end(), entry), entry);
+    }
+
+    // Remove a member (joinDate must be the one it was added with)
+    bool remove(int id, Date joinDate)
+    {
+        JoinDateEntry entry{joinDate.daysSinceEpoch(), id};
+        auto it = lower_bound(entries.begin(), entries.end(), entry);
+        if (it == entries.end() || it->days != entry.days || it->id != entry.id)
+            return false;
+
+        entries.erase(it);
+        return true;
+    }
+
+    // Replace the whole index in one sort (bulk loading)
+    void assign(vector<JoinDateEntry> unsorted)
+    {
+        entries = std::move(unsorted);
+        sort(entries.begin(), entries.end());
+    }
+
+    // Add many entries at once: sort them, append, merge (bulk imports)
+    void merge(vector<JoinDateEntry> unsorted)
+    {
+        sort(unsorted.begin(), unsorted.end());
+        size_t middle = entries.size();
+        entries.insert(entries.end(), unsorted.begin(), unsorted.end());
+        inplace_merge(entries.begin(), entries.begin() + middle, entries.end());
+    }
+
+    // Members who joined between 'from' and 'to' (both inclusive)
+    JoinDateRange range(Date from, Date to) const
+    {
+        const JoinDateEntry *data = entries.data();
+        if (to < from)
+            return JoinDateRange(data, data);
+
+        JoinDateEntry low{from.daysSinceEpoch(), INT32_MIN};
+        JoinDateEntry high{to.daysSinceEpoch(), INT32_MAX};
+        auto first = lower_bound(entries.begin(), entries.end(), low);
+        auto last = upper_bound(first, entries.end(), high);
+        return JoinDateRange(data + (first - entries.begin()), data + (last - entries.begin()));
+    }
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fstream>
+// Not Windows
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// MappedFile - read-only view of a whole file
+// Uses mmap on POSIX (pages are loaded lazily by the OS, nothing is copied);
+// falls back to reading the file into memory on Windows.
+class MappedFile
+{
+private:
+    const char *bytes = nullptr;
+    size_t length = 0;
+
+#ifdef _WIN32
+    vector<char> buffer;
+#else
+    void *mapping = nullptr;
+#endif
+
+public:
+    MappedFile() {}
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() { close(); }
+
+    // Map a file (returns false if it can't be opened)
+    bool open(const string &path)
+    {
+        close();
+
+#ifdef _WIN32
+        ifstream in(path, ios::binary | ios::ate);
+        if (!in)
+            return false;
+
+        buffer.resize((size_t)in.tellg());
+        in.seekg(0);
+        if (!buffer.empty() && !in.read(buffer.data(), (streamsize)buffer.size()))
+            return false;
+
+        bytes = buffer.data();
+        length = buffer.size();
+        return true;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        length = (size_t)info.st_size;
+        if (length > 0)
+        {
+            mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                mapping = nullptr;
+                length = 0;
+                ::close(fd);
+                return false;
+            }
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            bytes = (const char *)mapping;
+        }
+
+        ::close(fd); // The mapping stays valid after closing the descriptor
+        return true;
+#endif
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        buffer.clear();
+#else
+        if (mapping != nullptr)
+            munmap(mapping, length);
+        mapping = nullptr;
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const char *data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef MEMBER_COLUMNS_H
+#define MEMBER_COLUMNS_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../entities/Member.h"
+
+using namespace std;
+
+// MemberColumns - struct-of-arrays copy of the member table for scans and reports
+// Row i of every column describes the same member. Rows are removed by swapping
+// the last row into the hole, so the column order is NOT the listing order.
+class MemberColumns
+{
+private:
+    vector<int32_t> ids;
+    vector<uint8_t> subscriptionIds; // SubscriptionType values
+
+    unordered_map<int, size_t> rowById;
+
+public:
+    void reserve(size_t count)
+    {
+        ids.reserve(count);
+        subscriptionIds.reserve(count);
+        rowById.reserve(count);
+    }
+
+    // ---------- Keeping in sync with the row objects ----------
+
+    void append(const Member &member)
+    {
+        rowById[member.getId()] = ids.size();
+
+        ids.push_back(member.getId());
+        subscriptionIds.push_back((uint8_t)member.getSubscriptionType());
+    }
+
+    void setSubscription(int id, SubscriptionType type)
+    {
+        auto it = rowById.find(id);
+        if (it != rowById.end())
+            subscriptionIds[it->second] = (uint8_t)type;
+    }
+
+    void remove(int id)
+    {
+        auto it = rowById.find(id);
+        if (it == rowById.end())
+            return;
+
+        size_t hole = it->second;
+        size_t last = ids.size() - 1;
+        rowById.erase(it);
+
+        if (hole != last)
+        {
+            ids[hole] = ids[last];
+            subscriptionIds[hole] = subscriptionIds[last];
+            rowById[ids[hole]] = hole;
+        }
+
+        ids.pop_back();
+        subscriptionIds.pop_back();
+    }
+
+    size_t size() const { return ids.size(); }
+
+    // ---------- Filters (return matching member IDs) ----------
+
+    vector<int> filterBySubscription(SubscriptionType type) const
+    {
+        vector<int> result;
+        const uint8_t wanted = (uint8_t)type;
+        for (size_t i = 0; i < subscriptionIds.size(); i++)
+        {
+            if (subscriptionIds[i] == wanted)
+                result.push_back(ids[i]);
+        }
+        return result;
+    }
+};
+
+#endif
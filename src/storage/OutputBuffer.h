@@ -0,0 +1,124 @@
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// OutputBuffer - large reusable write buffer in front of a FILE*
+// Values are formatted straight into the buffer (no temporary strings) and
+// written out in big blocks, so memory stays constant however much is written.
+class OutputBuffer
+{
+private:
+    FILE *file;
+    vector<char> buffer;
+    size_t used = 0;
+    bool failed = false;
+
+    void ensure(size_t bytes)
+    {
+        if (used + bytes > buffer.size())
+            flush();
+        if (bytes > buffer.size())
+            buffer.resize(bytes);
+    }
+
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 20;
+
+    explicit OutputBuffer(FILE *target, size_t capacity = DEFAULT_CAPACITY) : file(target), buffer(capacity) {}
+    OutputBuffer(const OutputBuffer &) = delete;
+    OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+    ~OutputBuffer() { flush(); }
+
+    // Write everything buffered so far (false if the file refused it)
+    bool flush()
+    {
+        if (used > 0 && fwrite(buffer.data(), 1, used, file) != used)
+            failed = true;
+        used = 0;
+        return !failed;
+    }
+
+    bool ok() const { return !failed; }
+
+    void put(char c)
+    {
+        if (used == buffer.size())
+            flush();
+        buffer[used++] = c;
+    }
+
+    void put(string_view text)
+    {
+        ensure(text.size());
+        text.copy(buffer.data() + used, text.size());
+        used += text.size();
+    }
+
+    // Field for CSV: quoted (with "" escapes) only when it has to be
+    void putCsv(string_view text)
+    {
+        bool quote = !text.empty() && (text.front() == ' ' || text.back() == ' ');
+        for (char c : text)
+        {
+            if (c == ',' || c == '"' || c == '\n' || c == '\r')
+            {
+                quote = true;
+                break;
+            }
+        }
+        if (!quote)
+        {
+            put(text);
+            return;
+        }
+
+        put('"');
+        for (char c : text)
+        {
+            if (c == '"')
+                put('"');
+            put(c);
+        }
+        put('"');
+    }
+
+    // JSON string literal, quotes included
+    void putJson(string_view text)
+    {
+        static const char HEX[] = "0123456789abcdef";
+
+        put('"');
+        for (char c : text)
+        {
+            unsigned char byte = (unsigned char)c;
+            if (c == '"' || c == '\\')
+            {
+                put('\\');
+                put(c);
+            }
+            else if (c == '\n')
+                put("\\n");
+            else if (c == '\t')
+                put("\\t");
+            else if (c == '\r')
+                put("\\r");
+            else if (byte < 0x20)
+            {
+                put("\\u00");
+                put(HEX[byte >> 4]);
+                put(HEX[byte & 0xF]);
+            }
+            else
+                put(c);
+        }
+        put('"');
+    }
+};
+
+#endif
@@ -0,0 +1,358 @@
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// One search result (higher score = better match)
+struct SearchHit
+{
+    int id;
+    float score;
+};
+
+// SearchIndex - prefix and typo-tolerant lookup over names and emails
+//
+// - Prefix: every searchable term ("mohamed", "rashad", "mohamed rashad",
+//   "mohamed@gmail.com", "mohamed", "gmail.com") sits in a sorted vector, so all terms
+//   starting with the query are one lower_bound away.
+// - Fuzzy: trigram postings ("$mo", "moh", ... "ed$") -> IDs. A document
+//   matches when it shares at least half of the query's trigrams, which
+//   survives one or two typos in a name.
+//
+// Adds are appended to an unsorted tail that searches scan linearly; once
+// the tail outgrows MAX_UNSORTED_TERMS, the next search sorts it and merges
+// it in. Bulk loads cost one sort, and adds mixed with searches never re-sort
+// the whole vector. Concurrent searches are safe (the merge runs once, under
+// sortLock); adds / removes must not overlap with anything else.
+//
+// Removes leave a tombstone: the ID's terms and postings stay where they are
+// and searches skip them. Once the tombstones pass MAX_REMOVED_FRACTION of the
+// live documents, one pass drops them all, so a remove costs O(1) amortized
+// instead of shifting the term vector and walking shared postings like "com".
+class SearchIndex
+{
+public:
+    static const size_t DEFAULT_RESULTS = 5;
+
+private:
+    struct Document
+    {
+        string name;  // As given (shown in results)
+        string email;
+        vector<uint32_t> trigrams; // Sorted, distinct
+    };
+
+    // Scores: an exact term beats a prefix, a prefix beats a fuzzy match (< 1)
+    static constexpr float EXACT_SCORE = 3.0f;
+    static constexpr float PREFIX_SCORE = 2.0f;
+    static constexpr float MIN_FUZZY_SCORE = 0.5f;
+    static const size_t MAX_UNSORTED_TERMS = 1024;
+    static constexpr float MAX_REMOVED_FRACTION = 0.25f; // Tombstones per live document before compacting
+    static const size_t MIN_REMOVED_TO_COMPACT = 256;
+
+    unordered_map<int, Document> documents;
+    mutable vector<pair<string, int>> terms; // (term, ID): sorted prefix, then an unsorted tail
+    mutable size_t sortedTerms = 0;          // Length of the sorted prefix
+    mutable atomic<bool> termsDirty{false};  // Tail too long: merge before searching
+    mutable mutex sortLock;
+    unordered_map<uint32_t, vector<int>> postings; // Trigram -> IDs
+    unordered_set<int> removed;                    // Tombstones: IDs whose terms / postings are still in place
+
+    bool isRemoved(int id) const { return !removed.empty() && removed.count(id) != 0; }
+
+    // Drop the terms and postings of every tombstoned ID (one pass over each)
+    void compact()
+    {
+        size_t kept = 0, keptSorted = 0;
+        for (size_t i = 0; i < terms.size(); i++)
+        {
+            if (removed.count(terms[i].second) != 0)
+                continue;
+            if (i < sortedTerms)
+                keptSorted++;
+            if (kept != i)
+                terms[kept] = std::move(terms[i]);
+            kept++;
+        }
+        terms.resize(kept);
+        sortedTerms = keptSorted;
+        termsDirty = terms.size() - sortedTerms > MAX_UNSORTED_TERMS;
+
+        for (auto posting = postings.begin(); posting != postings.end();)
+        {
+            vector<int> &ids = posting->second;
+            ids.erase(std::remove_if(ids.begin(), ids.end(), [this](int id) { return removed.count(id) != 0; }),
+                      ids.end());
+            posting = ids.empty() ? postings.erase(posting) : next(posting);
+        }
+        removed.clear();
+    }
+
+    static string normalize(string_view text)
+    {
+        string result;
+        result.reserve(text.size());
+        bool space = false;
+        for (char c : text)
+        {
+            if (isspace((unsigned char)c))
+            {
+                space = !result.empty();
+                continue;
+            }
+            if (space)
+                result += ' ';
+            space = false;
+            result += (char)tolower((unsigned char)c);
+        }
+        return result;
+    }
+
+    // Whole name, each name word, whole email, email local part and domain (no duplicates)
+    static vector<string> termsOf(const Document &document)
+    {
+        string name = normalize(document.name);
+        string email = normalize(document.email);
+        vector<string> result = {name, email};
+
+        size_t start = 0;
+        while (start < name.size())
+        {
+            size_t end = name.find(' ', start);
+            if (end == string::npos)
+                end = name.size();
+            result.push_back(name.substr(start, end - start));
+            start = end + 1;
+        }
+
+        size_t at = email.find('@');
+        if (at != string::npos)
+        {
+            result.push_back(email.substr(0, at));
+            result.push_back(email.substr(at + 1));
+        }
+
+        sort(result.begin(), result.end());
+        result.erase(unique(result.begin(), result.end()), result.end());
+        result.erase(std::remove(result.begin(), result.end(), string()), result.end());
+        return result;
+    }
+
+    static uint32_t packTrigram(char a, char b, char c)
+    {
+        return ((uint32_t)(uint8_t)a << 16) | ((uint32_t)(uint8_t)b << 8) | (uint8_t)c;
+    }
+
+    // Distinct trigrams of "$text$" ('$' marks word boundaries, spaces included)
+    static vector<uint32_t> trigramsOf(string_view text)
+    {
+        string padded = "$" + string(text) + "$";
+        replace(padded.begin(), padded.end(), ' ', '$');
+        vector<uint32_t> result;
+        for (size_t i = 0; i + 2 < padded.size(); i++)
+            result.push_back(packTrigram(padded[i], padded[i + 1], padded[i + 2]));
+
+        sort(result.begin(), result.end());
+        result.erase(unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    // Trigrams of a document: name and email are indexed separately so a
+    // trigram never spans the two
+    static vector<uint32_t> trigramsOf(const Document &document)
+    {
+        vector<uint32_t> result = trigramsOf(normalize(document.name));
+        vector<uint32_t> email = trigramsOf(normalize(document.email));
+        result.insert(result.end(), email.begin(), email.end());
+
+        sort(result.begin(), result.end());
+        result.erase(unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    // Offer every document sharing at least MIN_FUZZY_SCORE of the query's trigrams
+    // Prefix filter: such a document must appear in one of the (count - needed + 1)
+    // rarest postings, so only those are scanned and each candidate is verified
+    // against its own trigrams, never walking the huge "gma" / "com" postings.
+    template <typename Offer>
+    void addFuzzyHits(const string &query, Offer &offer) const
+    {
+        vector<uint32_t> trigrams = trigramsOf(query);
+        size_t needed = (size_t)(trigrams.size() * MIN_FUZZY_SCORE + 0.999f);
+        if (needed == 0)
+            return;
+
+        vector<const vector<int> *> lists;
+        for (uint32_t trigram : trigrams)
+        {
+            auto posting = postings.find(trigram);
+            lists.push_back(posting != postings.end() ? &posting->second : nullptr);
+        }
+        auto rarer = [](const vector<int> *a, const vector<int> *b) {
+            return (a ? a->size() : 0) < (b ? b->size() : 0);
+        };
+        sort(lists.begin(), lists.end(), rarer);
+
+        unordered_set<int> checked;
+        for (size_t i = 0; i + needed <= trigrams.size(); i++)
+        {
+            if (lists[i] == nullptr)
+                continue;
+
+            for (int id : *lists[i])
+            {
+                if (isRemoved(id) || !checked.insert(id).second)
+                    continue;
+
+                const vector<uint32_t> &own = documents.at(id).trigrams;
+                size_t shared = 0;
+                for (uint32_t trigram : trigrams)
+                    shared += binary_search(own.begin(), own.end(), trigram);
+
+                float coverage = (float)shared / trigrams.size();
+                if (coverage >= MIN_FUZZY_SCORE)
+                    offer(id, coverage - own.size() * 1e-4f); // Ties: shorter document first
+            }
+        }
+    }
+
+    void sortTerms() const
+    {
+        if (!termsDirty.load(memory_order_acquire))
+            return;
+
+        lock_guard<mutex> guard(sortLock);
+        if (!termsDirty.load(memory_order_relaxed))
+            return; // Another reader sorted them meanwhile
+        auto middle = terms.begin() + sortedTerms;
+        sort(middle, terms.end());
+        inplace_merge(terms.begin(), middle, terms.end());
+        sortedTerms = terms.size();
+        termsDirty.store(false, memory_order_release);
+    }
+
+    static bool startsWith(const string &term, const string &prefix)
+    {
+        return term.compare(0, prefix.size(), prefix) == 0;
+    }
+
+public:
+    void reserve(size_t count)
+    {
+        documents.reserve(count);
+        terms.reserve(count * 4);
+    }
+
+    void clear()
+    {
+        documents.clear();
+        terms.clear();
+        sortedTerms = 0;
+        postings.clear();
+        removed.clear();
+        termsDirty = false;
+    }
+
+    size_t size() const { return documents.size(); }
+
+    // Index a document (replaces any document with the same ID)
+    void add(int id, string_view name, string_view email)
+    {
+        remove(id);
+        if (isRemoved(id))
+            compact(); // The old terms of this ID must not match the new document
+
+        Document document{string(name), string(email), {}};
+        for (string &term : termsOf(document))
+            terms.emplace_back(std::move(term), id);
+        if (terms.size() - sortedTerms > MAX_UNSORTED_TERMS)
+            termsDirty = true;
+
+        document.trigrams = trigramsOf(document);
+        for (uint32_t trigram : document.trigrams)
+            postings[trigram].push_back(id);
+
+        documents.emplace(id, std::move(document));
+    }
+
+    bool remove(int id)
+    {
+        auto it = documents.find(id);
+        if (it == documents.end())
+            return false;
+
+        documents.erase(it);
+        removed.insert(id);
+        if (removed.size() >= MIN_REMOVED_TO_COMPACT && removed.size() > documents.size() * MAX_REMOVED_FRACTION)
+            compact();
+        return true;
+    }
+
+    // Best 'limit' matches for a name / email fragment, best first
+    vector<SearchHit> search(string_view text, size_t limit = DEFAULT_RESULTS) const
+    {
+        string query = normalize(text);
+        if (query.empty() || limit == 0)
+            return {};
+
+        vector<SearchHit> hits;
+        unordered_map<int, size_t> hitOf; // ID -> position in hits
+        auto offer = [&](int id, float score) {
+            auto [it, inserted] = hitOf.try_emplace(id, hits.size());
+            if (inserted)
+                hits.push_back({id, score});
+            else
+                hits[it->second].score = max(hits[it->second].score, score);
+        };
+
+        // Prefix (and exact) matches: the short unsorted tail is scanned whole;
+        // in the sorted part exact terms come first in the range, so the scan
+        // stops as soon as 'limit' documents are found past them
+        sortTerms();
+        auto sortedEnd = terms.begin() + sortedTerms;
+        for (auto it = sortedEnd; it != terms.end(); ++it)
+        {
+            if (startsWith(it->first, query) && !isRemoved(it->second))
+                offer(it->second, it->first.size() == query.size() ? EXACT_SCORE : PREFIX_SCORE);
+        }
+        for (auto it = lower_bound(terms.begin(), sortedEnd, make_pair(query, INT32_MIN));
+             it != sortedEnd && startsWith(it->first, query); ++it)
+        {
+            if (isRemoved(it->second))
+                continue;
+            bool exact = it->first.size() == query.size();
+            if (!exact && hits.size() >= limit)
+                break;
+            offer(it->second, exact ? EXACT_SCORE : PREFIX_SCORE);
+        }
+
+        // Fuzzy matches only matter if prefixes did not fill the results
+        if (hits.size() < limit)
+            addFuzzyHits(query, offer);
+
+        // Stable: equal scores keep the alphabetical order of the prefix scan
+        auto better = [](const SearchHit &a, const SearchHit &b) { return a.score > b.score; };
+        stable_sort(hits.begin(), hits.end(), better);
+        if (hits.size() > limit)
+            hits.resize(limit);
+        return hits;
+    }
+
+    // Name / email of an indexed document, for showing results
+    const string &nameOf(int id) const { return documents.at(id).name; }
+    const string &emailOf(int id) const { return documents.at(id).email; }
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+// Sha256 - SHA-256 (FIPS 180-4), fed incrementally
+// A context is a plain value: copying one part-way through lets HMAC reuse its
+// keyed prefix instead of hashing the key again for every message.
+class Sha256
+{
+public:
+    static const size_t DIGEST_SIZE = 32;
+    static const size_t BLOCK_SIZE = 64;
+    using Digest = array<uint8_t, DIGEST_SIZE>;
+
+private:
+    static constexpr uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    uint8_t buffer[BLOCK_SIZE];
+    size_t buffered = 0;
+    uint64_t totalBytes = 0;
+
+    static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void compress(const uint8_t *block)
+    {
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++)
+        {
+            w[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16 |
+                   (uint32_t)block[4 * i + 2] << 8 | (uint32_t)block[4 * i + 3];
+        }
+        for (int i = 16; i < 64; i++)
+        {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; i++)
+        {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+public:
+    void update(const void *data, size_t length)
+    {
+        if (length == 0)
+            return;
+        const uint8_t *bytes = (const uint8_t *)data;
+        totalBytes += length;
+
+        if (buffered > 0)
+        {
+            size_t take = min(length, BLOCK_SIZE - buffered);
+            memcpy(buffer + buffered, bytes, take);
+            buffered += take;
+            bytes += take;
+            length -= take;
+            if (buffered < BLOCK_SIZE)
+                return;
+            compress(buffer);
+            buffered = 0;
+        }
+        for (; length >= BLOCK_SIZE; bytes += BLOCK_SIZE, length -= BLOCK_SIZE)
+            compress(bytes);
+        memcpy(buffer, bytes, length);
+        buffered = length;
+    }
+
+    // Pad, then write the digest (the context is spent afterwards)
+    void finish(uint8_t *digest)
+    {
+        uint64_t bits = totalBytes * 8;
+        uint8_t padding[BLOCK_SIZE + 8] = {0x80};
+        size_t padLength = (buffered < 56 ? 56 : 120) - buffered;
+        for (int i = 0; i < 8; i++)
+            padding[padLength + i] = (uint8_t)(bits >> (56 - 8 * i));
+        update(padding, padLength + 8);
+
+        for (int i = 0; i < 8; i++)
+        {
+            digest[4 * i] = (uint8_t)(state[i] >> 24);
+            digest[4 * i + 1] = (uint8_t)(state[i] >> 16);
+            digest[4 * i + 2] = (uint8_t)(state[i] >> 8);
+            digest[4 * i + 3] = (uint8_t)state[i];
+        }
+    }
+
+    static Digest compute(const void *data, size_t length)
+    {
+        Sha256 context;
+        context.update(data, length);
+        Digest digest;
+        context.finish(digest.data());
+        return digest;
+    }
+};
+
+// HmacSha256 - HMAC (RFC 2104) keyed once, then used for any number of messages
+class HmacSha256
+{
+private:
+    Sha256 inner; // Already fed key ^ ipad
+    Sha256 outer; // Already fed key ^ opad
+
+public:
+    HmacSha256(const void *key, size_t keyLength)
+    {
+        uint8_t block[Sha256::BLOCK_SIZE] = {};
+        if (keyLength > Sha256::BLOCK_SIZE)
+        {
+            Sha256::Digest hashed = Sha256::compute(key, keyLength);
+            memcpy(block, hashed.data(), hashed.size());
+        }
+        else if (keyLength > 0)
+            memcpy(block, key, keyLength);
+
+        uint8_t pad[Sha256::BLOCK_SIZE];
+        for (size_t i = 0; i < Sha256::BLOCK_SIZE; i++)
+            pad[i] = block[i] ^ 0x36;
+        inner.update(pad, sizeof(pad));
+        for (size_t i = 0; i < Sha256::BLOCK_SIZE; i++)
+            pad[i] = block[i] ^ 0x5c;
+        outer.update(pad, sizeof(pad));
+    }
+
+    // MAC of the concatenation of two parts (either may be empty)
+    void compute(const void *data, size_t length, const void *more, size_t moreLength, uint8_t *mac) const
+    {
+        Sha256 context = inner;
+        context.update(data, length);
+        context.update(more, moreLength);
+        uint8_t innerDigest[Sha256::DIGEST_SIZE];
+        context.finish(innerDigest);
+
+        context = outer;
+        context.update(innerDigest, sizeof(innerDigest));
+        context.finish(mac);
+    }
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Handle - generational reference to a value stored in a SlotMap<T>
+// A handle goes stale as soon as its value is erased: the slot's generation is
+// bumped, so the old handle no longer resolves (get() returns nullptr).
+template <typename T>
+struct Handle
+{
+    static const uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    uint32_t index = NO_SLOT;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == NO_SLOT; }
+
+    bool operator==(const Handle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Handle &other) const { return !(*this == other); }
+};
+
+// SlotMap - contiguous storage with stable generational handles
+// - Values live packed in one vector (cache-friendly iteration)
+// - insert / erase / get are O(1); erase swaps the last value into the hole
+// - Pointers returned by get() are only valid until the next insert or erase,
+//   keep the Handle<T> instead of the pointer.
+template <typename T>
+class SlotMap
+{
+private:
+    struct Slot
+    {
+        uint32_t denseIndex; // Position in 'values' (or next free slot when unused)
+        uint32_t generation; // Bumped on every erase
+    };
+
+    vector<T> values;            // Packed values
+    vector<uint32_t> denseToSlot; // values[i] is owned by slots[denseToSlot[i]]
+    vector<Slot> slots;
+    uint32_t freeHead = Handle<T>::NO_SLOT;
+
+    const Slot *findSlot(Handle<T> handle) const
+    {
+        if (handle.index >= slots.size())
+            return nullptr;
+
+        const Slot &slot = slots[handle.index];
+        if (slot.generation != handle.generation)
+            return nullptr;
+        return &slot;
+    }
+
+public:
+    // Insert a value and get its handle
+    template <typename... Args>
+    Handle<T> emplace(Args &&...args)
+    {
+        uint32_t slotIndex;
+        if (freeHead != Handle<T>::NO_SLOT)
+        {
+            // Reuse a free slot (its generation was bumped when it was freed)
+            slotIndex = freeHead;
+            freeHead = slots[slotIndex].denseIndex;
+        }
+        else
+        {
+            slotIndex = (uint32_t)slots.size();
+            slots.push_back({0, 1}); // Generation 0 is never valid
+        }
+
+        values.emplace_back(std::forward<Args>(args)...);
+        denseToSlot.push_back(slotIndex);
+        slots[slotIndex].denseIndex = (uint32_t)(values.size() - 1);
+
+        return {slotIndex, slots[slotIndex].generation};
+    }
+
+    Handle<T> insert(T value) { return emplace(std::move(value)); }
+
+    // Erase a value (returns false for stale handles)
+    bool erase(Handle<T> handle)
+    {
+        if (findSlot(handle) == nullptr)
+            return false;
+
+        Slot &slot = slots[handle.index];
+        uint32_t hole = slot.denseIndex;
+        uint32_t last = (uint32_t)(values.size() - 1);
+
+        // Move the last value into the hole to keep storage packed
+        if (hole != last)
+        {
+            values[hole] = std::move(values[last]);
+            denseToSlot[hole] = denseToSlot[last];
+            slots[denseToSlot[hole]].denseIndex = hole;
+        }
+        values.pop_back();
+        denseToSlot.pop_back();
+
+        // Invalidate old handles and push the slot on the free list
+        slot.generation++;
+        if (slot.generation == 0)
+            slot.generation = 1;
+        slot.denseIndex = freeHead;
+        freeHead = handle.index;
+        return true;
+    }
+
+    // Resolve a handle (nullptr when stale)
+    T *get(Handle<T> handle)
+    {
+        const Slot *slot = findSlot(handle);
+        return slot != nullptr ? &values[slot->denseIndex] : nullptr;
+    }
+
+    const T *get(Handle<T> handle) const
+    {
+        const Slot *slot = findSlot(handle);
+        return slot != nullptr ? &values[slot->denseIndex] : nullptr;
+    }
+
+    bool contains(Handle<T> handle) const { return findSlot(handle) != nullptr; }
+
+    // Handle of the value at a packed position (0 .. size()-1)
+    Handle<T> handleAt(size_t position) const
+    {
+        uint32_t slotIndex = denseToSlot[position];
+        return {slotIndex, slots[slotIndex].generation};
+    }
+
+    void reserve(size_t count)
+    {
+        values.reserve(count);
+        denseToSlot.reserve(count);
+        slots.reserve(count);
+    }
+
+    void clear()
+    {
+        // Erase one by one so every outstanding handle goes stale
+        while (!values.empty())
+            erase(handleAt(values.size() - 1));
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+    // Packed iteration (order changes when values are erased)
+    typename vector<T>::iterator begin() { return values.begin(); }
+    typename vector<T>::iterator end() { return values.end(); }
+    typename vector<T>::const_iterator begin() const { return values.begin(); }
+    typename vector<T>::const_iterator end() const { return values.end(); }
+};
+
+#endif
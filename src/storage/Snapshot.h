@@ -0,0 +1,343 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "../entities/Date.h"
+#include "../entities/Specialty.h"
+#include "../entities/Subscription.h"
+#include "Crc32.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// ==================== ON-DISK FORMAT ====================
+// [SnapshotHeader][AdminRecord...][MemberRecord...][TrainerRecord...]
+// [AssignmentRecord...][string pool]
+// All records are fixed size; strings are (offset, length) pairs into the pool.
+// The checksum covers everything after the header.
+
+struct SnapshotString
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct SnapshotHeader
+{
+    char magic[8];     // "ELFSNAP"
+    uint32_t version;  // Snapshot::VERSION
+    uint32_t checksum; // CRC-32 of the body
+    int32_t nextMemberId;
+    int32_t nextTrainerId;
+    uint64_t lastSequence; // Last write-ahead log record included
+    uint64_t adminCount;
+    uint64_t memberCount;
+    uint64_t trainerCount;
+    uint64_t assignmentCount;
+    uint64_t stringBytes;
+};
+
+struct AdminRecord
+{
+    SnapshotString name, email, password; // Password as a PasswordHash string (plain text before hashing)
+};
+
+struct MemberRecord
+{
+    int32_t id;
+    int32_t joinDays;     // Date::daysSinceEpoch
+    uint8_t subscription; // SubscriptionType
+    uint8_t reserved[3];
+    SnapshotString name, email, password;
+};
+
+struct TrainerRecord
+{
+    int32_t id;
+    uint8_t specialty; // Specialty
+    uint8_t reserved[3];
+    SnapshotString name, email, password;
+};
+
+struct AssignmentRecord
+{
+    int32_t trainerId;
+    int32_t memberId;
+};
+
+class Snapshot
+{
+public:
+    static const uint32_t VERSION = 2;
+    static constexpr char MAGIC[8] = "ELFSNAP";
+};
+
+// ==================== WRITER ====================
+
+// SnapshotWriter - collects records, then writes the file in one go
+// The file is written next to the target and renamed over it, so a crash
+// while saving never leaves a half-written snapshot behind.
+class SnapshotWriter
+{
+private:
+    SnapshotHeader header{};
+    vector<AdminRecord> admins;
+    vector<MemberRecord> members;
+    vector<TrainerRecord> trainers;
+    vector<AssignmentRecord> assignments;
+    string strings;
+
+    SnapshotString addString(const string &text)
+    {
+        SnapshotString ref{(uint32_t)strings.size(), (uint32_t)text.size()};
+        strings.append(text);
+        return ref;
+    }
+
+    template <typename T>
+    static bool writeSection(FILE *out, const vector<T> &records, uint32_t &crc)
+    {
+        if (records.empty())
+            return true;
+
+        size_t bytes = records.size() * sizeof(T);
+        crc = Crc32::update(crc, records.data(), bytes);
+        return fwrite(records.data(), 1, bytes, out) == bytes;
+    }
+
+public:
+    void reserve(size_t adminCount, size_t memberCount, size_t trainerCount)
+    {
+        admins.reserve(adminCount);
+        members.reserve(memberCount);
+        trainers.reserve(trainerCount);
+        strings.reserve((adminCount + memberCount + trainerCount) * 48);
+    }
+
+    void setNextIds(int nextMemberId, int nextTrainerId)
+    {
+        header.nextMemberId = nextMemberId;
+        header.nextTrainerId = nextTrainerId;
+    }
+
+    // Sequence of the last write-ahead log record reflected in this snapshot
+    void setLastSequence(uint64_t sequence)
+    {
+        header.lastSequence = sequence;
+    }
+
+    void addAdmin(const string &name, const string &email, const string &password)
+    {
+        admins.push_back({addString(name), addString(email), addString(password)});
+    }
+
+    void addMember(int id, Date joinDate, SubscriptionType subscription,
+                   const string &name, const string &email, const string &password)
+    {
+        MemberRecord record{};
+        record.id = id;
+        record.joinDays = joinDate.daysSinceEpoch();
+        record.subscription = (uint8_t)subscription;
+        record.name = addString(name);
+        record.email = addString(email);
+        record.password = addString(password);
+        members.push_back(record);
+    }
+
+    void addTrainer(int id, Specialty specialty, const string &name, const string &email, const string &password)
+    {
+        TrainerRecord record{};
+        record.id = id;
+        record.specialty = (uint8_t)specialty;
+        record.name = addString(name);
+        record.email = addString(email);
+        record.password = addString(password);
+        trainers.push_back(record);
+    }
+
+    void addAssignment(int trainerId, int memberId)
+    {
+        assignments.push_back({trainerId, memberId});
+    }
+
+    // Write the snapshot to 'path' (error describes what went wrong)
+    bool save(const string &path, string &error)
+    {
+        memcpy(header.magic, Snapshot::MAGIC, sizeof(header.magic));
+        header.version = Snapshot::VERSION;
+        header.adminCount = admins.size();
+        header.memberCount = members.size();
+        header.trainerCount = trainers.size();
+        header.assignmentCount = assignments.size();
+        header.stringBytes = strings.size();
+
+        string tempPath = path + ".tmp";
+        FILE *out = fopen(tempPath.c_str(), "wb");
+        if (out == nullptr)
+        {
+            error = "Cannot open " + tempPath + " for writing";
+            return false;
+        }
+
+        // Header goes first with a zero checksum, patched once the body is written
+        uint32_t crc = 0;
+        header.checksum = 0;
+        bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+        ok = ok && writeSection(out, admins, crc);
+        ok = ok && writeSection(out, members, crc);
+        ok = ok && writeSection(out, trainers, crc);
+        ok = ok && writeSection(out, assignments, crc);
+        if (ok && !strings.empty())
+        {
+            crc = Crc32::update(crc, strings.data(), strings.size());
+            ok = fwrite(strings.data(), 1, strings.size(), out) == strings.size();
+        }
+
+        header.checksum = crc;
+        ok = ok && fseek(out, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, out) == 1;
+        ok = ok && fflush(out) == 0;
+#ifndef _WIN32
+        ok = ok && fsync(fileno(out)) == 0;
+#endif
+        ok = (fclose(out) == 0) && ok;
+
+        if (!ok)
+        {
+            remove(tempPath.c_str());
+            error = "Failed writing " + tempPath;
+            return false;
+        }
+
+#ifdef _WIN32
+        remove(path.c_str()); // rename() does not replace existing files on Windows
+#endif
+        if (rename(tempPath.c_str(), path.c_str()) != 0)
+        {
+            error = "Cannot replace " + path;
+            return false;
+        }
+        return true;
+    }
+};
+
+// ==================== READER ====================
+
+// SnapshotReader - zero-copy access to a memory-mapped snapshot
+// Records are read straight from the mapping, strings come back as string_views
+// into it; nothing is parsed or allocated until the caller builds objects.
+class SnapshotReader
+{
+private:
+    MappedFile file;
+    SnapshotHeader header{};
+    const char *adminsAt = nullptr;
+    const char *membersAt = nullptr;
+    const char *trainersAt = nullptr;
+    const char *assignmentsAt = nullptr;
+    const char *stringsAt = nullptr;
+
+    template <typename T>
+    static T readRecord(const char *section, size_t index)
+    {
+        T record;
+        memcpy(&record, section + index * sizeof(T), sizeof(T));
+        return record;
+    }
+
+public:
+    static bool exists(const string &path)
+    {
+        FILE *in = fopen(path.c_str(), "rb");
+        if (in == nullptr)
+            return false;
+        fclose(in);
+        return true;
+    }
+
+    // Map and validate a snapshot (error describes what went wrong)
+    bool open(const string &path, string &error)
+    {
+        if (!file.open(path))
+        {
+            error = "Cannot open " + path;
+            return false;
+        }
+
+        if (file.size() < sizeof(SnapshotHeader))
+        {
+            error = "Snapshot is truncated";
+            return false;
+        }
+
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, Snapshot::MAGIC, sizeof(header.magic)) != 0)
+        {
+            error = "Not an El-Forma snapshot";
+            return false;
+        }
+        if (header.version != Snapshot::VERSION)
+        {
+            error = "Unsupported snapshot version " + to_string(header.version);
+            return false;
+        }
+
+        uint64_t bodyBytes = header.adminCount * sizeof(AdminRecord) +
+                             header.memberCount * sizeof(MemberRecord) +
+                             header.trainerCount * sizeof(TrainerRecord) +
+                             header.assignmentCount * sizeof(AssignmentRecord) +
+                             header.stringBytes;
+        if (file.size() != sizeof(SnapshotHeader) + bodyBytes)
+        {
+            error = "Snapshot size does not match its header";
+            return false;
+        }
+
+        const char *body = file.data() + sizeof(SnapshotHeader);
+        if (Crc32::compute(body, (size_t)bodyBytes) != header.checksum)
+        {
+            error = "Snapshot checksum mismatch";
+            return false;
+        }
+
+        adminsAt = body;
+        membersAt = adminsAt + header.adminCount * sizeof(AdminRecord);
+        trainersAt = membersAt + header.memberCount * sizeof(MemberRecord);
+        assignmentsAt = trainersAt + header.trainerCount * sizeof(TrainerRecord);
+        stringsAt = assignmentsAt + header.assignmentCount * sizeof(AssignmentRecord);
+        return true;
+    }
+
+    int nextMemberId() const { return header.nextMemberId; }
+    int nextTrainerId() const { return header.nextTrainerId; }
+    uint64_t lastSequence() const { return header.lastSequence; }
+
+    size_t adminCount() const { return (size_t)header.adminCount; }
+    size_t memberCount() const { return (size_t)header.memberCount; }
+    size_t trainerCount() const { return (size_t)header.trainerCount; }
+    size_t assignmentCount() const { return (size_t)header.assignmentCount; }
+
+    AdminRecord admin(size_t i) const { return readRecord<AdminRecord>(adminsAt, i); }
+    MemberRecord member(size_t i) const { return readRecord<MemberRecord>(membersAt, i); }
+    TrainerRecord trainer(size_t i) const { return readRecord<TrainerRecord>(trainersAt, i); }
+    AssignmentRecord assignment(size_t i) const { return readRecord<AssignmentRecord>(assignmentsAt, i); }
+
+    // Resolve a string reference (empty if it points outside the pool)
+    string_view text(SnapshotString ref) const
+    {
+        if ((uint64_t)ref.offset + ref.length > header.stringBytes)
+            return string_view();
+        return string_view(stringsAt + ref.offset, ref.length);
+    }
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// Span - read-only view of contiguous values (pointer + count, never owns them)
+// Lets entities expose their lists without copying them and without tying
+// callers to the container type. Invalidated when the viewed container changes.
+template <typename T>
+class Span
+{
+private:
+    const T *first = nullptr;
+    size_t count = 0;
+
+public:
+    Span() {}
+    Span(const T *data, size_t size) : first(data), count(size) {}
+    Span(const vector<T> &values) : first(values.data()), count(values.size()) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const T &operator[](size_t i) const { return first[i]; }
+
+    const T *begin() const { return first; }
+    const T *end() const { return first + count; }
+};
+
+#endif
@@ -0,0 +1,388 @@
+#ifndef WRITE_AHEAD_LOG_H
+#define WRITE_AHEAD_LOG_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+// Not Windows
+#else
+#include <unistd.h>
+#endif
+
+#include "Crc32.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// Kinds of logged mutations (values are stored on disk, never renumber)
+enum class WalRecordType : uint8_t
+{
+    AddMember = 1,
+    UpdateMember = 2,
+    DeleteMember = 3,
+    AddTrainer = 4,
+    UpdateTrainerSpecialty = 5,
+    AssignMember = 6,
+    DeleteTrainer = 7,
+    AddAdmin = 8 // name, email, password hash
+};
+
+// WalPayload - builds the body of one record (int32s and length-prefixed strings)
+class WalPayload
+{
+private:
+    string bytes;
+
+public:
+    WalPayload &addInt(int32_t value)
+    {
+        bytes.append((const char *)&value, sizeof(value));
+        return *this;
+    }
+
+    WalPayload &addString(string_view text)
+    {
+        addInt((int32_t)text.size());
+        bytes.append(text.data(), text.size());
+        return *this;
+    }
+
+    const string &data() const { return bytes; }
+};
+
+// WalRecord - one decoded record, fields are read back in the order they were added
+// Reading past the end sets ok() to false instead of crashing.
+class WalRecord
+{
+private:
+    const char *cursor;
+    const char *end;
+    bool valid = true;
+
+public:
+    uint64_t sequence;
+    WalRecordType type;
+
+    WalRecord(uint64_t seq, WalRecordType recordType, const char *payload, size_t length)
+        : cursor(payload), end(payload + length), sequence(seq), type(recordType) {}
+
+    int32_t readInt()
+    {
+        int32_t value = 0;
+        if (end - cursor < (ptrdiff_t)sizeof(value))
+        {
+            valid = false;
+            return 0;
+        }
+        memcpy(&value, cursor, sizeof(value));
+        cursor += sizeof(value);
+        return value;
+    }
+
+    string_view readString()
+    {
+        int32_t length = readInt();
+        if (length < 0 || end - cursor < length)
+        {
+            valid = false;
+            return string_view();
+        }
+        string_view text(cursor, (size_t)length);
+        cursor += length;
+        return text;
+    }
+
+    bool ok() const { return valid; }
+};
+
+// WriteAheadLog - append-only, checksummed log of every mutation
+//
+// Record layout: [u32 payload length][u32 CRC-32][u64 sequence][u8 type][payload]
+// (the CRC covers sequence, type and payload).
+//
+// Group commit: records are buffered and written + fsync'ed together once
+// 'recordsPerCommit' records are pending, or when the oldest pending record is
+// older than 'maxDelayMs' (checked on append). commit() forces it, e.g. at the
+// end of a bulk import. The defaults (1 record, 0 ms) fsync every mutation.
+//
+// Failures are reported, never dropped: a group that cannot be written (or
+// fsync'ed) stays pending and the file is cut back to its last committed
+// size, so a later commit retries it whole. append() then returns 0 and its
+// own record is withdrawn: the caller must not apply that mutation.
+// All members are safe to call from several threads (one internal mutex).
+class WriteAheadLog
+{
+private:
+    static const size_t HEADER_SIZE = 4 + 4 + 8 + 1;
+
+    FILE *file = nullptr;
+    string path;
+    string pending;             // Encoded records not yet written
+    size_t pendingRecords = 0;
+    uintmax_t committedSize = 0; // Bytes of the file known to be on disk
+    chrono::steady_clock::time_point oldestPending;
+    uint64_t nextSequence = 1;
+
+    size_t recordsPerCommit = 1;
+    int maxDelayMs = 0;
+
+    mutable mutex lock;
+
+    // Write and fsync everything pending (caller holds the lock)
+    // On failure the pending bytes are kept and the file is cut back to its
+    // last committed size (no torn group in front of the retry).
+    bool commitPending()
+    {
+        if (pendingRecords == 0)
+            return true;
+        if (file == nullptr)
+            return false;
+
+        if (fwrite(pending.data(), 1, pending.size(), file) == pending.size() && syncFile(file))
+        {
+            committedSize += pending.size();
+            pending.clear();
+            pendingRecords = 0;
+            return true;
+        }
+
+        fclose(file);
+        error_code ec;
+        filesystem::resize_file(path, committedSize, ec);
+        file = ec ? nullptr : fopen(path.c_str(), "ab"); // nullptr: every later append fails
+        return false;
+    }
+
+    bool closeFile()
+    {
+        if (file == nullptr)
+            return pendingRecords == 0;
+        bool ok = commitPending();
+        if (file != nullptr)
+            fclose(file);
+        file = nullptr;
+        return ok;
+    }
+
+    static bool syncFile(FILE *out)
+    {
+        if (fflush(out) != 0)
+            return false;
+#ifdef _WIN32
+        return _commit(_fileno(out)) == 0;
+#else
+        return fsync(fileno(out)) == 0;
+#endif
+    }
+
+public:
+    WriteAheadLog() {}
+    WriteAheadLog(const WriteAheadLog &) = delete;
+    WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+    ~WriteAheadLog() { close(); }
+
+    // Replay the records of 'logPath' whose sequence is > afterSequence
+    // Stops at the first torn / corrupt record (a crash mid-write) and cuts the
+    // file there. lastSequence receives the highest sequence found in the file.
+    static bool replay(const string &logPath, uint64_t afterSequence,
+                       const function<void(WalRecord &)> &apply,
+                       uint64_t &lastSequence, string &error)
+    {
+        lastSequence = afterSequence;
+
+        MappedFile log;
+        if (!log.open(logPath))
+            return true; // No log yet
+
+        const char *data = log.data();
+        size_t size = log.size();
+        size_t offset = 0;
+
+        while (size - offset >= HEADER_SIZE)
+        {
+            uint32_t length, crc;
+            uint64_t sequence;
+            memcpy(&length, data + offset, 4);
+            memcpy(&crc, data + offset + 4, 4);
+            memcpy(&sequence, data + offset + 8, 8);
+
+            if (size - offset - HEADER_SIZE < length)
+                break; // Torn tail
+            if (Crc32::compute(data + offset + 8, 8 + 1 + length) != crc)
+                break; // Corrupt tail
+
+            if (sequence > lastSequence)
+                lastSequence = sequence;
+
+            if (sequence > afterSequence)
+            {
+                WalRecord record(sequence, (WalRecordType)data[offset + 16], data + offset + HEADER_SIZE, length);
+                apply(record);
+            }
+            offset += HEADER_SIZE + length;
+        }
+
+        if (offset < size)
+        {
+            log.close();
+            error_code ec;
+            filesystem::resize_file(logPath, offset, ec);
+            if (ec)
+            {
+                error = "Cannot truncate damaged log " + logPath;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Open (or create) the log for appending; sequences continue after lastSequence
+    bool open(const string &logPath, uint64_t lastSequence, string &error)
+    {
+        lock_guard<mutex> guard(lock);
+        closeFile();
+
+        pending.clear();
+        pendingRecords = 0;
+        file = fopen(logPath.c_str(), "ab");
+        if (file == nullptr)
+        {
+            error = "Cannot open " + logPath + " for writing";
+            return false;
+        }
+        error_code ec;
+        committedSize = filesystem::file_size(logPath, ec);
+        if (ec)
+        {
+            fclose(file);
+            file = nullptr;
+            error = "Cannot read the size of " + logPath;
+            return false;
+        }
+        path = logPath;
+        nextSequence = lastSequence + 1;
+        return true;
+    }
+
+    bool isOpen() const
+    {
+        lock_guard<mutex> guard(lock);
+        return file != nullptr;
+    }
+
+    // Configure group commit (see class comment)
+    void setGroupCommit(size_t records, int delayMs)
+    {
+        lock_guard<mutex> guard(lock);
+        recordsPerCommit = records == 0 ? 1 : records;
+        maxDelayMs = delayMs < 0 ? 0 : delayMs;
+    }
+
+    // Log one mutation, returns its sequence number; 0 if it could not be
+    // logged (the log is closed, or its group failed to commit)
+    uint64_t append(WalRecordType type, const WalPayload &payload)
+    {
+        lock_guard<mutex> guard(lock);
+        if (file == nullptr)
+            return 0;
+
+        const string &body = payload.data();
+        uint32_t length = (uint32_t)body.size();
+        uint64_t sequence = nextSequence++;
+        uint8_t typeByte = (uint8_t)type;
+
+        char header[HEADER_SIZE];
+        memcpy(header, &length, 4);
+        memcpy(header + 8, &sequence, 8);
+        header[16] = (char)typeByte;
+
+        uint32_t crc = Crc32::update(0, header + 8, 9);
+        crc = Crc32::update(crc, body.data(), body.size());
+        memcpy(header + 4, &crc, 4);
+
+        if (pendingRecords == 0)
+            oldestPending = chrono::steady_clock::now();
+        pending.append(header, HEADER_SIZE);
+        pending.append(body);
+        pendingRecords++;
+
+        bool batchFull = pendingRecords >= recordsPerCommit;
+        bool batchOld = maxDelayMs > 0 &&
+                        chrono::steady_clock::now() - oldestPending >= chrono::milliseconds(maxDelayMs);
+        if ((batchFull || batchOld) && !commitPending())
+        {
+            // Withdraw this record; the earlier ones stay pending for the next commit
+            pending.resize(pending.size() - HEADER_SIZE - body.size());
+            pendingRecords--;
+            nextSequence--;
+            return 0;
+        }
+        return sequence;
+    }
+
+    // Write and fsync everything pending (one fsync for the whole group)
+    bool commit()
+    {
+        lock_guard<mutex> guard(lock);
+        return commitPending();
+    }
+
+    // Drop the pending records without writing them (after a failed commit,
+    // when their mutations were reported as failed)
+    void discardPending()
+    {
+        lock_guard<mutex> guard(lock);
+        nextSequence -= pendingRecords;
+        pending.clear();
+        pendingRecords = 0;
+    }
+
+    // Highest sequence handed out so far
+    uint64_t lastSequence() const
+    {
+        lock_guard<mutex> guard(lock);
+        return nextSequence - 1;
+    }
+
+    // Empty the log (after its records made it into a snapshot)
+    // Pending records are in the snapshot too, so they are dropped. False if
+    // the log cannot be reopened: it then stays closed and append() fails.
+    bool reset()
+    {
+        lock_guard<mutex> guard(lock);
+        if (path.empty())
+            return false; // Never opened
+
+        if (file != nullptr)
+            fclose(file);
+        pending.clear();
+        pendingRecords = 0;
+        committedSize = 0;
+        file = fopen(path.c_str(), "wb");
+        if (file != nullptr && syncFile(file))
+            return true;
+        if (file != nullptr)
+            fclose(file);
+        file = nullptr;
+        return false;
+    }
+
+    // Commit what is pending and close (false if it could not be committed)
+    bool close()
+    {
+        lock_guard<mutex> guard(lock);
+        return closeFile();
+    }
+};
+
+#endif